@@ -0,0 +1,401 @@
+/*
+ * Benchmark driver for the sorting algorithms of the library.
+ *  Every sort mode is run on several input distributions and sizes, every run
+ *  is done in a child process so its peak memory can be measured on its own.
+ *  The results are printed as CSV or as one JSON object per line.
+ *
+ *  Usage: bench_sort [--format csv|json] [--min-size N] [--max-size N]
+ *                    [--sorts name,...] [--distributions name,...]
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "list.h"
+#include "integer_list.h"
+#include "merge_sort.h"
+#include "array_sort.h"
+#include "parallel_sort.h"
+#include "adaptive_sort.h"
+#include "gather_sort.h"
+#include "specialized_sort.h"
+#include "unrolled_list.h"
+#include "compact_list.h"
+#include "utils.h"
+
+#define ARRAY_SIZE(x) sizeof((x))/sizeof((x)[0])
+
+/* Inputs larger than this are skipped by the O(n^2) sorts */
+#define BENCH_QUADRATIC_MAX_SIZE 20000
+
+/*************************  Instrumentation  **************************/
+
+/* Counted from the worker threads of the parallel sorts as well, so they are only accessed atomically */
+static uint64_t comparisons = 0;
+static uint64_t allocations = 0;
+static bool countAllocations = false;
+
+/**
+ * \brief Compare function counting the amount of comparisons
+ */
+static bool lessThanForBench(int32_t a, int32_t b) {
+    __atomic_fetch_add(&comparisons, 1, __ATOMIC_RELAXED);
+    return a < b;
+}
+
+/* The benchmark is linked with --wrap=xzalloc, so every reservation of the library goes through here */
+void *__real_xzalloc(size_t count, size_t size);
+
+void *__wrap_xzalloc(size_t count, size_t size){
+    if(countAllocations) __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    return __real_xzalloc(count, size);
+}
+
+static uint64_t nowNs(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+/***************************  Distributions  ****************************/
+
+typedef void DistributionFunction(int32_t *values, size_t count);
+
+static void distributionRandom(int32_t *values, size_t count){
+    for(size_t i = 0; i < count; i++) values[i] = (int32_t) (((uint32_t) rand() << 16) ^ (uint32_t) rand());
+}
+
+static void distributionSorted(int32_t *values, size_t count){
+    for(size_t i = 0; i < count; i++) values[i] = (int32_t) i;
+}
+
+static void distributionReversed(int32_t *values, size_t count){
+    for(size_t i = 0; i < count; i++) values[i] = (int32_t) (count - i);
+}
+
+static void distributionFewUnique(int32_t *values, size_t count){
+    for(size_t i = 0; i < count; i++) values[i] = rand() % 16;
+}
+
+static void distributionSawtooth(int32_t *values, size_t count){
+    for(size_t i = 0; i < count; i++) values[i] = (int32_t) (i % 1000);
+}
+
+static void distributionOrganPipe(int32_t *values, size_t count){
+    for(size_t i = 0; i < count; i++) values[i] = (int32_t) ((i < count / 2) ? i : count - i);
+}
+
+struct Distribution {
+    const char *name;
+    DistributionFunction *fill;
+};
+
+static const struct Distribution distributions[] = {
+    { "random",     distributionRandom },
+    { "sorted",     distributionSorted },
+    { "reversed",   distributionReversed },
+    { "few_unique", distributionFewUnique },
+    { "sawtooth",   distributionSawtooth },
+    { "organ_pipe", distributionOrganPipe },
+};
+
+/*****************************  Sorts  *******************************/
+
+enum BenchInput {
+    BENCH_INPUT_LIST,       /* Sorts working on struct List */
+    BENCH_INPUT_UNROLLED,   /* Sorts working on struct UnrolledList */
+    BENCH_INPUT_COMPACT,    /* Sorts working on struct CompactList */
+    BENCH_INPUT_ARRAY       /* Sorts working on int32_t arrays */
+};
+
+typedef void ArraySortFunction(int32_t *values, size_t count);
+typedef void UnrolledSortFunction(struct UnrolledList *list, IntegerCompareFunction compare);
+typedef void CompactSortFunction(struct CompactList *list, IntegerCompareFunction compare);
+
+static void arrayRadixSort(int32_t *values, size_t count){
+    integerArrayRadixSort(values, count, NULL);
+}
+
+static void arrayMergeSort(int32_t *values, size_t count){
+    integerArrayMergeSort(values, count, lessThanForBench, NULL);
+}
+
+static void arrayParallelMergeSort(int32_t *values, size_t count){
+    integerArrayParallelMergeSort(values, count, lessThanForBench, 0, PARALLEL_SORT_DEFAULT_CUTOFF, NULL);
+}
+
+/* The _ascending variants sort with lessThan, taking the sorting network and
+ * radix paths that lessThanForBench would skip, so they count no comparisons */
+static void arrayMergeSortAscending(int32_t *values, size_t count){
+    integerArrayMergeSort(values, count, lessThan, NULL);
+}
+
+static void arrayParallelMergeSortAscending(int32_t *values, size_t count){
+    integerArrayParallelMergeSort(values, count, lessThan, 0, PARALLEL_SORT_DEFAULT_CUTOFF, NULL);
+}
+
+/* The radix sorts count no comparisons */
+static void arrayParallelRadixSort(int32_t *values, size_t count){
+    integerArrayParallelRadixSort(values, count, 0, PARALLEL_SORT_DEFAULT_CUTOFF, NULL);
+}
+
+static void listParallelRadixSort(struct List *list, IntegerCompareFunction compare){
+    integerListParallelRadixSort(list, 0);
+}
+
+/* The specialized sorts inline the ascending order, so they count no comparisons */
+static void arraySpecializedSort(int32_t *values, size_t count){
+    int32AscendingSort(values, count, NULL);
+}
+
+static void listSpecializedSort(struct List *list, IntegerCompareFunction compare){
+    int32AscendingListSort(list);
+}
+
+struct BenchSort {
+    const char *name;
+    enum BenchInput input;
+    SortFunction *listSort;
+    UnrolledSortFunction *unrolledSort;
+    ArraySortFunction *arraySort;
+    CompactSortFunction *compactSort;
+    size_t maxSize;              /* Larger inputs are skipped, 0 for no limit */
+    IntegerCompareFunction *compare; /* Given to the list sorts, NULL for lessThanForBench */
+};
+
+static const struct BenchSort sorts[] = {
+    { "list_merge",          BENCH_INPUT_LIST,     integerListMergeSort,        NULL, NULL, NULL, 0 },
+    { "list_merge_in_place", BENCH_INPUT_LIST,     integerListMergeSortInPlace, NULL, NULL, NULL, 0 },
+    { "list_natural_merge",  BENCH_INPUT_LIST,     integerListNaturalMergeSort, NULL, NULL, NULL, 0 },
+    { "list_parallel_merge", BENCH_INPUT_LIST,     integerListParallelSort,     NULL, NULL, NULL, 0 },
+    { "list_hybrid",         BENCH_INPUT_LIST,     integerListHybridSort,       NULL, NULL, NULL, 0 },
+    { "list_gather_relink",  BENCH_INPUT_LIST,     integerListGatherRelinkSort, NULL, NULL, NULL, 0 },
+    { "list_adaptive",       BENCH_INPUT_LIST,     integerListAdaptiveSort,     NULL, NULL, NULL, 0 },
+    { "list_merge_in_place_ascending", BENCH_INPUT_LIST, integerListMergeSortInPlace, NULL, NULL, NULL, 0, lessThan },
+    { "list_parallel_merge_ascending", BENCH_INPUT_LIST, integerListParallelSort,     NULL, NULL, NULL, 0, lessThan },
+    { "list_hybrid_ascending",         BENCH_INPUT_LIST, integerListHybridSort,       NULL, NULL, NULL, 0, lessThan },
+    { "list_gather_relink_ascending",  BENCH_INPUT_LIST, integerListGatherRelinkSort, NULL, NULL, NULL, 0, lessThan },
+    { "list_adaptive_ascending",       BENCH_INPUT_LIST, integerListAdaptiveSort,     NULL, NULL, NULL, 0, lessThan },
+    { "list_specialized",    BENCH_INPUT_LIST,     listSpecializedSort,         NULL, NULL, NULL, 0 },
+    { "list_parallel_radix", BENCH_INPUT_LIST,     listParallelRadixSort,       NULL, NULL, NULL, 0 },
+    { "list_naive",          BENCH_INPUT_LIST,     naiveSort,                   NULL, NULL, NULL, BENCH_QUADRATIC_MAX_SIZE },
+    { "unrolled_merge",      BENCH_INPUT_UNROLLED, NULL, unrolledListSort,      NULL, NULL, 0 },
+    { "compact_merge",       BENCH_INPUT_COMPACT,  NULL, NULL, NULL, compactListSort,        0 },
+    { "array_radix",         BENCH_INPUT_ARRAY,    NULL, NULL, arrayRadixSort,         NULL, 0 },
+    { "array_merge",         BENCH_INPUT_ARRAY,    NULL, NULL, arrayMergeSort,         NULL, 0 },
+    { "array_parallel_merge",BENCH_INPUT_ARRAY,    NULL, NULL, arrayParallelMergeSort, NULL, 0 },
+    { "array_merge_ascending",          BENCH_INPUT_ARRAY, NULL, NULL, arrayMergeSortAscending,         NULL, 0 },
+    { "array_parallel_merge_ascending", BENCH_INPUT_ARRAY, NULL, NULL, arrayParallelMergeSortAscending, NULL, 0 },
+    { "array_specialized",   BENCH_INPUT_ARRAY,    NULL, NULL, arraySpecializedSort,   NULL, 0 },
+    { "array_parallel_radix",BENCH_INPUT_ARRAY,    NULL, NULL, arrayParallelRadixSort, NULL, 0 },
+};
+
+/*****************************  Driver  ******************************/
+
+enum BenchFormat {
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+};
+
+struct BenchResult {
+    uint64_t wallNs;
+    uint64_t comparisons;
+    uint64_t allocations;
+    long peakRssKb;
+    bool sorted;
+};
+
+/**
+ * \brief Callback checking that the values of a list are in ascending order
+ */
+static bool checkAscending(void *value, void *data){
+    int64_t *previous = (int64_t *) data;
+    int32_t v = *(int32_t *) value;
+    if(v < *previous){
+        *previous = INT64_MAX;
+        return false;
+    }
+    *previous = v;
+    return true;
+}
+
+static void runSort(const struct BenchSort *sort, int32_t *values, size_t count, struct BenchResult *result){
+    uint64_t start = 0;
+    int64_t previous = INT64_MIN;
+    __atomic_store_n(&comparisons, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&allocations, 0, __ATOMIC_RELAXED);
+    IntegerCompareFunction *compare = (sort->compare != NULL) ? sort->compare : lessThanForBench;
+    if(sort->input == BENCH_INPUT_LIST){
+        struct List *list = integerListCreateWithElements(count, values);
+        countAllocations = true;
+        start = nowNs();
+        sort->listSort(list, compare);
+        result->wallNs = nowNs() - start;
+        countAllocations = false;
+        listForEach(list, checkAscending, &previous);
+        listDestroy(list);
+    } else if(sort->input == BENCH_INPUT_UNROLLED){
+        struct UnrolledList *list = unrolledListCreateWithElements(count, values);
+        countAllocations = true;
+        start = nowNs();
+        sort->unrolledSort(list, compare);
+        result->wallNs = nowNs() - start;
+        countAllocations = false;
+        unrolledListForEach(list, checkAscending, &previous);
+        unrolledListDestroy(list);
+    } else if(sort->input == BENCH_INPUT_COMPACT){
+        struct CompactList *list = compactListCreateWithElements(count, values);
+        countAllocations = true;
+        start = nowNs();
+        sort->compactSort(list, compare);
+        result->wallNs = nowNs() - start;
+        countAllocations = false;
+        compactListForEach(list, checkAscending, &previous);
+        compactListDestroy(list);
+    } else {
+        countAllocations = true;
+        start = nowNs();
+        sort->arraySort(values, count);
+        result->wallNs = nowNs() - start;
+        countAllocations = false;
+        for(size_t i = 0; i < count; i++){
+            if(!checkAscending(&values[i], &previous)) break;
+        }
+    }
+    result->comparisons = __atomic_load_n(&comparisons, __ATOMIC_RELAXED);
+    result->allocations = __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+    result->sorted = (previous != INT64_MAX);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result->peakRssKb = usage.ru_maxrss;
+}
+
+static void printResult(enum BenchFormat format, const struct BenchSort *sort, const struct Distribution *distribution,
+                        size_t count, const struct BenchResult *result){
+    double nsPerElement = (double) result->wallNs / (double) count;
+    if(format == BENCH_FORMAT_JSON){
+        printf("{\"sort\":\"%s\",\"distribution\":\"%s\",\"size\":%lu,\"wall_ns\":%llu,\"ns_per_element\":%.3f,"
+               "\"comparisons\":%llu,\"allocations\":%llu,\"peak_rss_kb\":%ld,\"sorted\":%s}\n",
+               sort->name, distribution->name, (unsigned long) count, (unsigned long long) result->wallNs,
+               nsPerElement, (unsigned long long) result->comparisons, (unsigned long long) result->allocations,
+               result->peakRssKb, result->sorted ? "true" : "false");
+    } else {
+        printf("%s,%s,%lu,%llu,%.3f,%llu,%llu,%ld,%d\n", sort->name, distribution->name, (unsigned long) count,
+               (unsigned long long) result->wallNs, nsPerElement, (unsigned long long) result->comparisons,
+               (unsigned long long) result->allocations, result->peakRssKb, result->sorted ? 1 : 0);
+    }
+    fflush(stdout);
+}
+
+/**
+ * \brief Run a single benchmark in a child process, so the peak RSS belongs to this run only.
+ * \return true if the child finished and the output was sorted.
+ */
+static bool runBenchmark(enum BenchFormat format, const struct BenchSort *sort, const struct Distribution *distribution, size_t count){
+    fflush(stdout);
+    pid_t pid = fork();
+    if(pid < 0){
+        perror("fork");
+        return false;
+    }
+    if(pid == 0){
+        srand(1);
+        int32_t *values = (int32_t *) xzalloc(count, sizeof(int32_t));
+        distribution->fill(values, count);
+        struct BenchResult result = {0};
+        runSort(sort, values, count, &result);
+        printResult(format, sort, distribution, count, &result);
+        free(values);
+        exit(result.sorted ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS);
+}
+
+/**
+ * \brief Tells if name is in a comma separated list, a NULL list selects everything
+ */
+static bool selected(const char *list, const char *name){
+    if(list == NULL) return true;
+    size_t length = strlen(name);
+    for(const char *itr = list; itr != NULL; itr = strchr(itr, ',')){
+        if(*itr == ',') itr++;
+        if((strncmp(itr, name, length) == 0) && ((itr[length] == ',') || (itr[length] == '\0'))) return true;
+    }
+    return false;
+}
+
+static void usage(const char *program){
+    fprintf(stderr, "Usage: %s [--format csv|json] [--min-size N] [--max-size N] "
+                    "[--sorts name,...] [--distributions name,...]\n", program);
+    fprintf(stderr, "Sorts:");
+    for(size_t i = 0; i < ARRAY_SIZE(sorts); i++) fprintf(stderr, " %s", sorts[i].name);
+    fprintf(stderr, "\nDistributions:");
+    for(size_t i = 0; i < ARRAY_SIZE(distributions); i++) fprintf(stderr, " %s", distributions[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, const char **argv){
+    enum BenchFormat format = BENCH_FORMAT_CSV;
+    size_t minSize = 1000;
+    size_t maxSize = 1000000;
+    const char *sortNames = NULL;
+    const char *distributionNames = NULL;
+
+    for(int i = 1; i < argc; i++){
+        if((strcmp(argv[i], "--format") == 0) && (i + 1 < argc)){
+            i++;
+            if(strcmp(argv[i], "json") == 0){
+                format = BENCH_FORMAT_JSON;
+            } else if(strcmp(argv[i], "csv") == 0){
+                format = BENCH_FORMAT_CSV;
+            } else {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if((strcmp(argv[i], "--min-size") == 0) && (i + 1 < argc)){
+            minSize = strtoull(argv[++i], NULL, 10);
+        } else if((strcmp(argv[i], "--max-size") == 0) && (i + 1 < argc)){
+            maxSize = strtoull(argv[++i], NULL, 10);
+        } else if((strcmp(argv[i], "--sorts") == 0) && (i + 1 < argc)){
+            sortNames = argv[++i];
+        } else if((strcmp(argv[i], "--distributions") == 0) && (i + 1 < argc)){
+            distributionNames = argv[++i];
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(minSize == 0) minSize = 1;
+
+    if(format == BENCH_FORMAT_CSV){
+        printf("sort,distribution,size,wall_ns,ns_per_element,comparisons,allocations,peak_rss_kb,sorted\n");
+    }
+
+    bool succeeded = true;
+    for(size_t count = minSize; count <= maxSize; count *= 10){
+        for(size_t s = 0; s < ARRAY_SIZE(sorts); s++){
+            if(!selected(sortNames, sorts[s].name)) continue;
+            if((sorts[s].maxSize != 0) && (count > sorts[s].maxSize)) continue;
+            for(size_t d = 0; d < ARRAY_SIZE(distributions); d++){
+                if(!selected(distributionNames, distributions[d].name)) continue;
+                if(!runBenchmark(format, &sorts[s], &distributions[d], count)){
+                    fprintf(stderr, "Error: %s failed on %s input of size %lu\n", sorts[s].name,
+                            distributions[d].name, (unsigned long) count);
+                    succeeded = false;
+                }
+            }
+        }
+        if(count > SIZE_MAX / 10) break;
+    }
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
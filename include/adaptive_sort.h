@@ -0,0 +1,107 @@
+/**
+ * Adaptive sort of integer lists
+ *  A single entry point that samples the list for its size, the order already
+ *  present (runs between neighbours and inversions between sampled values)
+ *  and the range of its values, and dispatches to the sort expected to be the
+ *  fastest for that input. The choice is reported back and the thresholds used
+ *  to make it can be tuned.
+ */
+#ifndef __ADAPTIVE_SORT_H__
+#define __ADAPTIVE_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+
+enum AdaptiveSortStrategy {
+    ADAPTIVE_SORT_NONE,          /* The list was already sorted by compare */
+    ADAPTIVE_SORT_INSERTION,     /* integerListInsertionSort */
+    ADAPTIVE_SORT_NATURAL_MERGE, /* integerListNaturalMergeSort, for input made of long runs */
+    ADAPTIVE_SORT_RADIX,         /* Gather radix sort, parallel for large lists, only with an ascending compare */
+    ADAPTIVE_SORT_PARALLEL,      /* integerListParallelSort */
+    ADAPTIVE_SORT_MERGE          /* integerListMergeSortInPlace */
+};
+
+struct AdaptiveSortThresholds {
+    size_t insertionMaxSize;        /* Lists up to this size use insertion sort without sampling */
+    size_t sampleSize;              /* Amount of neighbour pairs and values sampled */
+    size_t runMaxBreakPerMille;     /* Run breaks per mille of the sampled pairs up to this use the natural merge */
+    size_t runMaxInversionPerMille; /* Inversions per mille up to this (or from 1000 minus it) use the natural
+                                       merge as well, while the run breaks stay under 4 times the limit above */
+    size_t radixMinSize;            /* Lists from this size use the radix sort when possible */
+    size_t radixSmallRangeMinSize;  /* The same when the sampled values span less than 2^16 */
+    size_t parallelMinSize;         /* Lists from this size use the parallel sorts */
+};
+
+/* Default thresholds */
+#define ADAPTIVE_SORT_DEFAULT_THRESHOLDS {  \
+    .insertionMaxSize = 24,                 \
+    .sampleSize = 256,                      \
+    .runMaxBreakPerMille = 16,              \
+    .runMaxInversionPerMille = 8,           \
+    .radixMinSize = 2048,                   \
+    .radixSmallRangeMinSize = 512,          \
+    .parallelMinSize = 262144               \
+}
+
+/**
+ * \brief What the sampling found and the strategy chosen from it.
+ * Lists that are marked sorted and still are, checked with one walk, or short
+ * enough for insertion sort are not sampled, their sampled fields are left at 0.
+ */
+struct AdaptiveSortReport {
+    enum AdaptiveSortStrategy strategy;
+    size_t count;             /* Elements in the list */
+    size_t sampledPairs;      /* Sampled neighbour pairs, each one followed by another pair */
+    size_t descents;          /* Sampled pairs where the second value goes strictly before the first */
+    size_t runBreaks;         /* Sampled pairs whose direction differs from the following pair */
+    size_t estimatedRuns;     /* Ascending or descending runs expected in the whole list */
+    size_t sampledValues;     /* Values sampled to estimate the inversions and the range */
+    size_t inversions;        /* Pairs of sampled values out of order */
+    int32_t minimum;          /* Smallest sampled value */
+    int32_t maximum;          /* Largest sampled value */
+};
+
+/**
+ * \brief Replace the thresholds used to choose the strategy
+ */
+void adaptiveSortSetThresholds(const struct AdaptiveSortThresholds *thresholds);
+
+/**
+ * \brief Copy the thresholds in use into thresholds
+ */
+void adaptiveSortGetThresholds(struct AdaptiveSortThresholds *thresholds);
+
+/**
+ * \brief Name of a strategy, for logging
+ */
+const char *adaptiveSortStrategyName(enum AdaptiveSortStrategy strategy);
+
+/**
+ * \brief Sample the list and choose a strategy without sorting it.
+ * The values are sampled at a fixed stride over one walk of the list.
+ * \param list    The list to be examined
+ * \param compare Function that tells if a should be located before b
+ * \param report  Receives the findings and the strategy
+ * \return        RET_OK or RET_FAIL if list or report are NULL.
+ */
+enum ListReturnType integerListAdaptivePlan(const struct List *list, IntegerCompareFunction compare,
+                                            struct AdaptiveSortReport *report);
+
+/**
+ * \brief Sort a list with the strategy chosen by integerListAdaptivePlan.
+ * All the strategies are stable.
+ * \param list    The list to be sorted
+ * \param compare Function that tells if a should be located before b
+ * \param report  Receives the findings and the strategy used, can be NULL
+ * \return        RET_OK or RET_FAIL if list is NULL.
+ */
+enum ListReturnType integerListAdaptiveSortWithReport(struct List *list, IntegerCompareFunction compare,
+                                                      struct AdaptiveSortReport *report);
+
+/**
+ * \brief Sort a list with the strategy chosen by integerListAdaptivePlan, matches SortFunction.
+ */
+void integerListAdaptiveSort(struct List *list, IntegerCompareFunction compare);
+
+#endif //__ADAPTIVE_SORT_H__
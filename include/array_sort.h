@@ -0,0 +1,78 @@
+/**
+ * Sorting algorithms working on contiguous arrays of integers
+ */
+#ifndef __ARRAY_SORT_H__
+#define __ARRAY_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "merge_sort.h"
+
+/**
+ * \brief A scratch buffer that can be reused between several sorts to avoid
+ * reserving memory on every call.
+ */
+struct ArraySortScratch {
+    int32_t *buffer;    /* Memory used by the sort algorithms */
+    size_t capacity;    /* Amount of int32_t elements that fit in buffer */
+};
+
+/**
+ * \brief Creates a scratch buffer for the array sorts
+ * \param capacity Initial amount of elements reserved, it can be 0.
+ * \return         A pointer to the newly created scratch buffer.
+ */
+struct ArraySortScratch *arraySortScratchCreate(size_t capacity);
+
+/**
+ * \brief Make sure the scratch buffer can hold at least count elements.
+ * The previous contents of the buffer are not kept when it has to grow.
+ * \param scratch The scratch buffer
+ * \param count   Amount of elements needed
+ * \return        A pointer to the buffer with room for count elements.
+ */
+int32_t *arraySortScratchReserve(struct ArraySortScratch *scratch, size_t count);
+
+/**
+ * \brief Frees the memory related to a scratch buffer
+ * \param scratch The scratch buffer to be freed
+ */
+void arraySortScratchDestroy(struct ArraySortScratch *scratch);
+
+/**
+ * \brief LSD radix sort of an array of integers in ascending order.
+ * The values are sorted one byte at a time, the sign bit is flipped so the
+ * negative values are placed first. Passes where all the values share the same
+ * byte are skipped. The sort is stable and runs in O(n) time.
+ * \param values  Array to be sorted
+ * \param count   Amount of elements in the array
+ * \param scratch Scratch buffer to be used, if NULL a temporary one is reserved.
+ */
+void integerArrayRadixSort(int32_t *values, size_t count, struct ArraySortScratch *scratch);
+
+/**
+ * \brief Stable merge of 2 sorted arrays of integers into dst.
+ * On ties the values from the left array go first.
+ * \param left       First sorted array
+ * \param leftCount  Amount of elements in the left array
+ * \param right      Second sorted array
+ * \param rightCount Amount of elements in the right array
+ * \param dst        Output array with room for leftCount+rightCount elements
+ * \param compare    Function that tells if a should be located before b
+ */
+void integerArrayMerge(const int32_t *left, size_t leftCount, const int32_t *right, size_t rightCount,
+                       int32_t *dst, IntegerCompareFunction compare);
+
+/**
+ * \brief Stable merge sort of an array of integers using a compare function.
+ * Small blocks are sorted with insertion sort and then merged bottom up,
+ * moving the values between the array and the scratch buffer on every pass.
+ * With an ascending compare function, see integerCompareIsAscending, the blocks
+ * are sorted by int32SortBlock.
+ * \param values  Array to be sorted
+ * \param count   Amount of elements in the array
+ * \param compare Function that tells if a should be located before b
+ * \param scratch Scratch buffer to be used, if NULL a temporary one is reserved.
+ */
+void integerArrayMergeSort(int32_t *values, size_t count, IntegerCompareFunction compare, struct ArraySortScratch *scratch);
+
+#endif //__ARRAY_SORT_H__
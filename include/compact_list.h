@@ -0,0 +1,131 @@
+/**
+ * A compact doubly linked list of integers, the nodes live in one array and
+ * link to each other with 32 bit indices
+ */
+#ifndef __COMPACT_LIST_H__
+#define __COMPACT_LIST_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+
+/* Index used as the NULL link */
+#define COMPACT_LIST_NIL UINT32_MAX
+/* Largest amount of nodes, every index but COMPACT_LIST_NIL is usable */
+#define COMPACT_LIST_MAX_NODES ((size_t) UINT32_MAX)
+/* Nodes reserved by the first insertion into a list created without capacity */
+#define COMPACT_LIST_DEFAULT_CAPACITY 64
+
+/* A node takes 12 bytes, half of the links of a struct ListNode */
+struct CompactListNode {
+    int32_t value;  /* Value stored */
+    uint32_t next;  /* Index of the next node, COMPACT_LIST_NIL at the tail */
+    uint32_t prev;  /* Index of the previous node, COMPACT_LIST_NIL at the head */
+};
+
+struct CompactList {
+    struct CompactListNode *nodes;  /* Storage of all the nodes, indexed by the links */
+    size_t capacity;                /* Nodes that fit in the storage */
+    size_t used;                    /* Nodes of the storage handed out at least once */
+    uint32_t head;                  /* Index of the first node */
+    uint32_t tail;                  /* Index of the last node */
+    uint32_t freeList;              /* Released nodes linked through next, reused first */
+    size_t count;                   /* Element count */
+};
+
+/**
+ * \brief Creates an empty Compact List
+ * \param capacity Nodes reserved up front, it can be 0.
+ * \return A pointer to the newly created list.
+ */
+struct CompactList *compactListCreate(size_t capacity);
+
+/**
+ * \brief Creates a Compact List holding a set of values, with a single reservation for the nodes
+ * \param count    Amount of elements to be added to the new list
+ * \param elements Elements to be added to the list
+ * \return         A pointer to a new list containing the given elements
+ */
+struct CompactList *compactListCreateWithElements(size_t count, const int32_t elements[]);
+
+/**
+ * \brief Frees the memory related to a Compact List
+ * \param list The list to be freed
+ */
+void compactListDestroy(struct CompactList *list);
+
+/**
+ * \brief Make room for at least capacity nodes. The storage is moved when it
+ * grows, but the indices of the nodes are kept.
+ * \return RET_OK or RET_FAIL if capacity is over COMPACT_LIST_MAX_NODES.
+ */
+enum ListReturnType compactListReserve(struct CompactList *list, size_t capacity);
+
+/**
+ * \brief Adds an integer to the begining of the list
+ * \param list  The list to be modified
+ * \param value Value to be added to the list
+ * \return      RET_OK if it was successful or RET_FAIL on a failure.
+ */
+enum ListReturnType compactListAppendStart(struct CompactList *list, int32_t value);
+
+/**
+ * \brief Adds an integer to the end of the list
+ * \param list  The list to be modified
+ * \param value Value to be added to the list
+ * \return      RET_OK if it was successful or RET_FAIL on a failure.
+ */
+enum ListReturnType compactListAppendEnd(struct CompactList *list, int32_t value);
+
+/**
+ * \brief Insert an integer after a node of the list
+ * \param list     The list to be modified
+ * \param previous Index of the node placed before the new one, COMPACT_LIST_NIL inserts at the head
+ * \param value    Value to be added to the list
+ * \return         Index of the new node or COMPACT_LIST_NIL on a failure.
+ */
+uint32_t compactListInsertAfter(struct CompactList *list, uint32_t previous, int32_t value);
+
+/**
+ * \brief Remove a node from the list, its index can be reused by later insertions
+ * \param list The list to be modified
+ * \param node Index of the node to be removed
+ * \return     RET_OK or RET_FAIL if the list is empty or node is COMPACT_LIST_NIL.
+ */
+enum ListReturnType compactListRemove(struct CompactList *list, uint32_t node);
+
+/**
+ * \brief Get the first element from the list and remove it from the list
+ * \param list  The list to be modified
+ * \param value Output for the removed value, can be NULL
+ * \return      RET_OK if a value was removed or RET_FAIL if the list is empty.
+ */
+enum ListReturnType compactListPop(struct CompactList *list, int32_t *value);
+
+/**
+ * \brief Run the given callback function on all elements.
+ * The callback gets a pointer to every int32_t value, it should return true to
+ * continue with the next element or false to end the iteration.
+ * \param list     List containing the elements
+ * \param callback Callback function to be called for each element
+ * \param userData User data to be passed for every element
+ */
+void compactListForEach(struct CompactList *list, ListCallback callback, void *userData);
+
+/**
+ * \brief Print all elements in a Compact List
+ * \param list List to be printed
+ */
+void compactListPrint(struct CompactList *list);
+
+/**
+ * \brief Stable merge sort of a Compact List that only relinks the nodes.
+ * The nodes are merged through their next indices with a binary counter of
+ * O(log n) pending runs, and the prev indices are rebuilt in a final pass.
+ * Runs already in order, or in reverse order, are joined with a single comparison.
+ * \param list    The list to be sorted
+ * \param compare Function that tells if a should be located before b
+ */
+void compactListSort(struct CompactList *list, IntegerCompareFunction compare);
+
+#endif //__COMPACT_LIST_H__
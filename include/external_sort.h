@@ -0,0 +1,40 @@
+/**
+ * External sort of binary files of int32_t values larger than the memory
+ */
+#ifndef __EXTERNAL_SORT_H__
+#define __EXTERNAL_SORT_H__
+#include <stddef.h>
+#include "list.h"
+
+/* Memory used by default, in bytes */
+#define EXTERNAL_SORT_DEFAULT_MEMORY_BUDGET (256 * 1024 * 1024)
+
+struct ExternalSortOptions {
+    size_t memoryBudget;  /* Bytes used for the sorted chunks and the merge buffers */
+    const char *tempDir;  /* Directory for the temporary run files, NULL uses TMPDIR or /tmp */
+    size_t maxFanIn;      /* Maximum amount of runs merged at once, 0 picks it from the budget */
+};
+
+/**
+ * \brief Fill the options with the default values
+ * \param options The options to be initialized
+ */
+void externalSortDefaultOptions(struct ExternalSortOptions *options);
+
+/**
+ * \brief Sort a binary file of native endian int32_t values in ascending order.
+ * The input is read in chunks that fit in the memory budget, every chunk is
+ * sorted with integerArrayRadixSort and written as a run to a temporary file.
+ * The runs are then merged with a k-way merge, in several passes if there are
+ * more runs than maxFanIn. The output is written by a second thread while the
+ * merge fills the next buffer, and the kernel is asked to read ahead the next
+ * block of every run. The temporary files are removed as soon as they are created,
+ * so nothing is left behind if the process dies.
+ * \param inputPath  Path to the file to be sorted
+ * \param outputPath Path to the sorted file, it is created or truncated. It can be the input file.
+ * \param options    Sort options, NULL uses the defaults.
+ * \return           RET_OK if it was successful or RET_FAIL on a failure.
+ */
+enum ListReturnType externalSortFile(const char *inputPath, const char *outputPath, const struct ExternalSortOptions *options);
+
+#endif //__EXTERNAL_SORT_H__
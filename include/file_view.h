@@ -0,0 +1,37 @@
+/**
+ * Read only integer lists over memory mapped files
+ */
+#ifndef __FILE_VIEW_H__
+#define __FILE_VIEW_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+
+/**
+ * \brief A file of native endian int32_t values mapped in memory, the same
+ * format used by externalSortFile, and a read only list over its values.
+ */
+struct IntegerFileView {
+    struct List *list;      /* View over the values, see integerListCreateView */
+    const int32_t *values;  /* Values of the file, NULL if it is empty */
+    size_t count;           /* Amount of values, trailing bytes of a partial value are ignored */
+    void *map;              /* Mapped memory, NULL if the file is empty */
+    size_t size;            /* Size of the mapping in bytes */
+};
+
+/**
+ * \brief Map a file and create a read only list over its values without copying them.
+ * The pages are mapped private and read only, the nodes of the list can be
+ * relinked by the sorts while the file is never modified.
+ * \param path Path to the file
+ * \return     A pointer to the view, NULL if the file can not be opened or mapped.
+ */
+struct IntegerFileView *integerFileViewOpen(const char *path);
+
+/**
+ * \brief Destroy the list and unmap the file
+ * \param view The view to be closed
+ */
+void integerFileViewClose(struct IntegerFileView *view);
+
+#endif //__FILE_VIEW_H__
@@ -0,0 +1,57 @@
+/**
+ * Gather-sort-scatter sorting of integer lists
+ *  The list is walked once to copy its values (or value and node pairs) to a
+ *  contiguous buffer, the buffer is sorted with a cache friendly array sort and
+ *  the result is written back to the list. Large lists avoid the pointer chasing
+ *  of the node by node merges.
+ */
+#ifndef __GATHER_SORT_H__
+#define __GATHER_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+#include "array_sort.h"
+
+/* Lists with less elements than this are sorted without gathering them */
+#define GATHER_SORT_DEFAULT_THRESHOLD 2048
+
+enum GatherSortMode {
+    GATHER_SORT_VALUES, /* Sort the values and write them back in the same nodes */
+    GATHER_SORT_RELINK  /* Sort value and node pairs and relink the nodes in order */
+};
+
+/**
+ * \brief Sort a list through a contiguous buffer.
+ * With an ascending compare function, see integerCompareIsAscending, the buffer
+ * is sorted with a radix sort, otherwise with integerArrayMergeSort. Both keep
+ * equal values in their order.
+ * \param list    The list to be sorted
+ * \param compare Function that tells if a should be located before b
+ * \param mode    How the sorted buffer is written back to the list, readOnly lists are always relinked
+ * \param scratch Scratch buffer used by GATHER_SORT_VALUES for the gathered values and
+ *                the sort, it grows to 2 * count elements. If NULL temporary ones are reserved.
+ * \return        RET_OK on success, RET_FAIL if list is NULL.
+ */
+enum ListReturnType integerListGatherSort(struct List *list, IntegerCompareFunction compare,
+                                          enum GatherSortMode mode, struct ArraySortScratch *scratch);
+
+/**
+ * \brief Set the size from which integerListHybridSort gathers the list,
+ * GATHER_SORT_DEFAULT_THRESHOLD by default.
+ */
+void integerListGatherSetThreshold(size_t threshold);
+
+/**
+ * \brief Sorts the lists smaller than the threshold with integerListMergeSortInPlace
+ * and the larger ones with integerListGatherSort writing back the values. It can
+ * be used as a SortFunction.
+ */
+void integerListHybridSort(struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief integerListGatherSort relinking the nodes, it can be used as a SortFunction.
+ */
+void integerListGatherRelinkSort(struct List *list, IntegerCompareFunction compare);
+
+#endif //__GATHER_SORT_H__
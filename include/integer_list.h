@@ -7,6 +7,25 @@
 #include <stdlib.h>
 #include "list.h"
 
+/**
+ * \brief An integer list node storing its value inline, in the same allocation
+ * as the links. The value pointer of the node points to the value field, so all
+ * the integer list functions work with it while reading from a single cache line.
+ */
+struct IntegerListNode {
+    struct ListNode node;  /* Links of the node, node.value points to value */
+    int32_t value;         /* Value stored */
+};
+
+/**
+ * \brief Get the integer stored in a node of an Integer List
+ * \param node The node
+ * \return     The value of the node
+ */
+static inline int32_t integerListNodeValue(const struct ListNode *node){
+    return *(const int32_t *)node->value;
+}
+
 /**
  * \brief Creates a Integer List Node with a given value
  * \param value Value to initialize the node.
@@ -14,6 +33,42 @@
  */
 struct ListNode *integerListNodeCreate(int32_t value);
 
+/**
+ * \brief Creates an empty Integer List whose nodes and values are carved from a pool.
+ * \param nodesPerBlock Amount of nodes reserved at once
+ * \return              A pointer to the newly created list.
+ */
+struct List* integerListCreatePooled(size_t nodesPerBlock);
+
+/**
+ * \brief Creates an Integer List Node storing the value inline, with a single allocation.
+ * \param value Value to initialize the node.
+ * \return      A pointer to the created node.
+ */
+struct ListNode *integerListInlineNodeCreate(int32_t value);
+
+/**
+ * \brief Frees a node created with integerListInlineNodeCreate
+ * \param node The node to be freed
+ */
+void integerListFreeInlineNode(struct ListNode *node);
+
+/**
+ * \brief Creates an empty Integer List whose nodes store their values inline.
+ * \return A pointer to the newly created list.
+ */
+struct List* integerListCreateInline(void);
+
+/**
+ * \brief Creates a node of the right kind for a list, taken from its pool if it
+ * has one, inline if the list uses inline nodes or boxed otherwise. The node is
+ * not added to the list.
+ * \param list  The list the node will be added to
+ * \param value Value to initialize the node.
+ * \return      A pointer to the created node, NULL if the list is readOnly.
+ */
+struct ListNode *integerListNodeCreateFor(struct List *list, int32_t value);
+
 /**
  * \brief Adds an integer to the begining of the list
  * \param list  The list to be modified
@@ -40,6 +95,60 @@ void integerListFreeNode(struct ListNode *node);
  */
 struct List* integerListCreateWithElements(size_t count, int32_t elements[]);
 
+/* Nodes per block reserved by the pool of a bulk list once its first block is full */
+#define INTEGER_LIST_BULK_GROWTH 1024
+
+/**
+ * \brief Creates an Integer List with a set of values in a single block of memory.
+ * Every node is stored next to its value in a pool sized for count nodes, and
+ * they are linked while the block is filled, so the list costs a few reservations
+ * instead of 2 per element. Further nodes are taken from the same pool, in blocks
+ * of INTEGER_LIST_BULK_GROWTH nodes.
+ * \param count    Amount of elements to be added to the new list
+ * \param elements Elements to be added to the list
+ * \return         A pointer to a new pooled list containing the given elements
+ */
+struct List* integerListCreateBulk(size_t count, const int32_t elements[]);
+
+/**
+ * \brief Creates a read only Integer List over a caller array, without copying it.
+ * The values of the nodes point straight into elements, which must outlive the
+ * list. The list is readOnly: sorts only relink its nodes and nodes can not be
+ * added, but they can be removed. Destroying the list leaves the array untouched.
+ * \param count    Amount of elements in the array
+ * \param elements Values seen by the list
+ * \return         A pointer to the new view
+ */
+struct List* integerListCreateView(size_t count, const int32_t elements[]);
+
+/**
+ * \brief Creates an Integer List with inline values and Initializes it with a set of values
+ * \param count    Amount of elements to be added to the new list
+ * \param elements Elements to be added to the list
+ * \return         A pointer to a new list containing the given elements
+ */
+struct List* integerListCreateInlineWithElements(size_t count, int32_t elements[]);
+
+/**
+ * \brief Swap the integers stored in 2 nodes of an Integer List.
+ * The list is not known, so its sorted prefix is not reset and readOnly lists
+ * are not detected, integerListSwapValues does both.
+ * \param nodeA One of the nodes to swap their values
+ * \param nodeB The other node involved
+ */
+void integerListNodeSwapValues(struct ListNode *nodeA, struct ListNode *nodeB);
+
+/**
+ * \brief Swap the integers stored in 2 nodes of an Integer List, resetting its
+ * sorted prefix. Unlike listSwapValues the value pointers are kept, so it is
+ * safe for nodes whose values live in the same allocation as the node.
+ * \param list  The list holding both nodes
+ * \param nodeA One of the nodes to swap their values
+ * \param nodeB The other node involved
+ * \return      RET_OK, or RET_FAIL if a parameter is NULL or the list is readOnly.
+ */
+enum ListReturnType integerListSwapValues(struct List *list, struct ListNode *nodeA, struct ListNode *nodeB);
+
 /**
  * \brief Print an element of an Integer List
  * \param value Pointer to the value to be printed
@@ -20,11 +20,17 @@ struct ListNode {
 
 typedef void ListFreeNodeCallback(struct ListNode *);
 
+struct NodePool;
+
 struct List {
     struct ListNode *head; /* First element of the list */
     struct ListNode *tail; /* Last element of the list, changes with every insertion */
     size_t count;          /* Element count */
     ListFreeNodeCallback *freeNode; /* Callback function to free a node */
+    struct NodePool *pool; /* Pool owning the nodes, NULL if they are reserved one by one */
+    size_t sortedCount;    /* Length of the prefix known to be sorted in the sortedBy order */
+    const void *sortedBy;  /* Order of the sorted prefix, the compare function used by the sort */
+    bool readOnly;         /* The values belong to someone else, sorts only relink the nodes */
 };
 
 /**
@@ -41,6 +47,53 @@ struct ListNode *listNodeCreate(void *value);
  */
 struct List* listCreate(ListFreeNodeCallback freeNode);
 
+/**
+ * \brief Creates a List whose nodes are taken from a pool
+ * The list takes the ownership of the pool, its nodes should be taken with
+ * nodePoolAlloc and they are all released at once when the list is destroyed.
+ * \param freeNode A callback function to be run to free a node, not used for pooled nodes.
+ * \param pool     The pool owning the nodes of the list
+ * \return A pointer to the newly created list.
+ */
+struct List* listCreateWithPool(ListFreeNodeCallback freeNode, struct NodePool *pool);
+
+/**
+ * \brief Frees a node that was removed from a list.
+ * The node goes back to the pool of the list if it has one, otherwise it is
+ * freed with the freeNode callback of the list.
+ * \param list The list the node belonged to
+ * \param node The node to be freed
+ */
+void listNodeFree(struct List *list, struct ListNode *node);
+
+/**
+ * \brief Tells if the nodes of other can be linked into list as they are, that
+ * is when listNodeFree frees them the same way on both lists: neither list has
+ * a pool and both use the same freeNode callback.
+ * \param list  The list that would receive the nodes
+ * \param other The list owning the nodes
+ * \return      true if the nodes can be moved, false if their values must be copied.
+ */
+bool listCanMoveNodes(const struct List *list, const struct List *other);
+
+/**
+ * \brief Record that the first count elements of the list are sorted.
+ * The sorts call it when they end. Appending at the end keeps the sorted prefix,
+ * popping shrinks it and any other insertion or swap through the list resets it.
+ * \param list  The list that was sorted
+ * \param count Length of the sorted prefix
+ * \param order The order of the prefix, usually the compare function of the sort
+ */
+void listMarkSorted(struct List *list, size_t count, const void *order);
+
+/**
+ * \brief Length of the prefix of the list known to be sorted in the given order
+ * \param list  The list to be checked
+ * \param order The wanted order, the prefix only counts if it was sorted in it
+ * \return      The length of the sorted prefix, 0 if unknown.
+ */
+size_t listSortedCount(const struct List *list, const void *order);
+
 /**
  * \brief Adds a node to the begining of the list
  * \param list  The list to be modified
@@ -82,6 +135,14 @@ enum ListReturnType listInsertBefore(struct List* list, struct ListNode *next, s
  */
 struct ListNode *listPop(struct List *list);
 
+/**
+ * \brief Unlink a node from anywhere in the list, the node is not freed.
+ * \param list The list to be modified
+ * \param node The node to be removed, it must belong to the list
+ * \return     RET_OK if it was succesfull or RET_FAIL otherwise.
+ */
+enum ListReturnType listRemove(struct List *list, struct ListNode *node);
+
 /**
  * \brief Frees the memory related to a list
  * \param list The list to be freed
@@ -106,9 +167,18 @@ void listForEach(struct List *list, ListCallback callback, void *userData);
 
 /**
  * \brief Swap the contents of 2 given list nodes
+ * The list is not known, so its sorted prefix is not reset, listSwapValues does it.
  * \param nodeA One of the nodes to swap their values
  * \param nodeB The other node involved
  */
 void listNodeSwapValues(struct ListNode *nodeA, struct ListNode *nodeB);
 
+/**
+ * \brief Swap the contents of 2 nodes of a list, resetting its sorted prefix.
+ * \param list  The list holding both nodes
+ * \param nodeA One of the nodes to swap their values
+ * \param nodeB The other node involved
+ */
+void listSwapValues(struct List *list, struct ListNode *nodeA, struct ListNode *nodeB);
+
 #endif //__LIST_H__
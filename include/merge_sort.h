@@ -4,6 +4,7 @@
 #ifndef __MERGE_SORT_H__
 #define __MERGE_SORT_H__
 
+#include <stdint.h>
 #include "list.h"
 
 /**
@@ -44,14 +45,69 @@ void multiListPrint(struct List *list);
  */
 typedef bool IntegerCompareFunction(int32_t a, int32_t b);
 
+/**
+ * \brief Record that the whole list is sorted by compare, every sort calls it when it ends
+ */
+static inline void integerListMarkSorted(struct List *list, IntegerCompareFunction compare){
+    listMarkSorted(list, list->count, (const void *) compare);
+}
+
+/* Default amount of consecutive wins from one list before a merge starts galloping */
+#define MERGE_SORT_DEFAULT_MIN_GALLOP 7
+
+/**
+ * \brief Configure the galloping mode of the merges.
+ * After the given amount of consecutive wins from one side, the merge uses an
+ * exponential search along that side and splices the whole winning segment at
+ * once. Set it to 0 to disable galloping. It applies to all the merge sorts.
+ * \param wins Consecutive wins needed to start galloping
+ */
+void integerListMergeSetMinGallop(size_t wins);
+
+/**
+ * \brief Find the last node of the sorted chain starting at start that can be
+ * placed before the key. An exponential search probes 1, 2, 4... nodes ahead
+ * and a binary search narrows the last interval, so only O(log k) comparisons
+ * are done for a segment of k nodes, although the nodes are still walked.
+ * \param start   First node of the segment, it must not be NULL
+ * \param key     Value the segment ends at
+ * \param compare Order of the chain
+ * \param strict  Accept only the nodes strictly before the key, otherwise ties are accepted as well
+ * \return        The last accepted node or NULL if start itself is not accepted.
+ */
+struct ListNode *integerListGallop(struct ListNode *start, int32_t key, IntegerCompareFunction compare, bool strict);
+
 /**
  * \brief Merge 2 ordered lists of integer elements into the right list.
  *
- * Merges 2 ordered lists of integers into the right list. The left list gets destroyed.
+ * Merges 2 ordered lists of integers into the right list by relinking their nodes,
+ * galloping through long segments won by the same list. The merge is stable, on
+ * ties the elements of the right list go first. The left list gets destroyed.
+ * Nodes are only moved between lists that free them the same way, see
+ * listCanMoveNodes, otherwise the values of left are copied into new nodes of right.
  * \param right The List that will get updated with the sorted values from both lists.
  * \param left  The list that is a source of values and will be consumed by the right list.
+ * \return      RET_OK, or RET_FAIL if the values of left would have to be copied into
+ *              a readOnly right list, both lists are left untouched then.
  */
-void integerListMergeSortMerge(struct List **right, struct List *left, IntegerCompareFunction compare);
+enum ListReturnType integerListMergeSortMerge(struct List **right, struct List *left, IntegerCompareFunction compare);
+
+/**
+ * \brief Merge an array of ordered lists of integers into the first list.
+ *
+ * The nodes are relinked using a tournament (loser) tree, so every element costs
+ * about log2(count) comparisons and the lists are merged in a single pass. The
+ * merge is stable, on ties the elements of the lists with lower index go first.
+ * Nodes are only moved between lists that free them the same way, see
+ * listCanMoveNodes, the values of the other lists are copied into new nodes of lists[0].
+ * \param lists   Array of sorted lists, all the values end in lists[0] and the
+ *                other lists are left empty.
+ * \param count   Amount of lists in the array
+ * \param compare Function that tells if a should be located before b
+ * \return        RET_OK, or RET_FAIL if lists is NULL or empty, or values would
+ *                have to be copied into a readOnly lists[0].
+ */
+enum ListReturnType integerListMergeMany(struct List **lists, size_t count, IntegerCompareFunction compare);
 
 /**
  * \brief A MergeSort implementation using the generic list in this file.
@@ -64,11 +120,59 @@ void integerListMergeSortMerge(struct List **right, struct List *left, IntegerCo
  */
 void integerListMergeSort(struct List *list, IntegerCompareFunction compare);
 
+/**
+ * \brief A MergeSort implementation that only relinks the existing nodes.
+ * No memory is reserved while sorting, the nodes are merged by rewiring their
+ * next and prev pointers using a small fixed stack of O(log n) pending runs.
+ * The sort is stable, the head and tail of the list are fixed at the end.
+ * With an ascending compare function, see integerCompareIsAscending, blocks of
+ * SIMD_SORT_BLOCK_SIZE nodes are ordered first with int32SortBlock and relinked,
+ * so only the links are ever modified and the values stay in their nodes.
+ */
+void integerListMergeSortInPlace(struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief An adaptive MergeSort that takes advantage of the existing order.
+ * The list is scanned for natural runs, ascending runs are used as they are and
+ * strictly descending runs are reversed. The runs are merged following the TimSort
+ * stack policy, so sorted or reversed input is handled in O(n) and nearly sorted
+ * input gets close to it. The sort is stable and only relinks the nodes.
+ */
+void integerListNaturalMergeSort(struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief Length of the prefix of the list that is sorted by compare.
+ * The prefix recorded by the last sort is only a hint, values can be changed
+ * through the nodes without the list knowing it, so the recorded prefix is
+ * checked with one walk and only its part that is still sorted is returned.
+ */
+size_t integerListSortedPrefix(const struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief Sort a list reusing its sorted prefix.
+ * The list tracks the length of the prefix left sorted by the last sort with the
+ * same compare function, values appended at the end since then form an unsorted
+ * suffix. Only the suffix of m elements is sorted, with integerListMergeSortInPlace,
+ * and then it is merged into the prefix, so the cost is O(m log m + n) instead of
+ * O(n log n). The prefix is checked with integerListSortedPrefix first, so values
+ * changed through the nodes are handled. Without a sorted prefix the whole list
+ * is sorted. The sort is stable.
+ */
+void integerListIncrementalSort(struct List *list, IntegerCompareFunction compare);
+
 /**
  * \brief Data type for the sorting function
  */
 typedef void SortFunction(struct List *list, IntegerCompareFunction compare);
 
+/**
+ * \brief Stable insertion sort that relinks the nodes.
+ * Every node is moved back after the last node that is not placed after it, so
+ * it runs in O(n + d) where d is the amount of inversions, fast for short or
+ * nearly sorted lists.
+ */
+void integerListInsertionSort(struct List *list, IntegerCompareFunction compare);
+
 /**
  * \brief A naive implementation of a sort function with O(n^2) complexity
  */
@@ -79,4 +183,24 @@ void naiveSort(struct List *list, IntegerCompareFunction compare);
  */
 bool lessThan(int32_t a, int32_t b);
 
+/**
+ * \brief Declare a compare function ordering exactly like lessThan, e.g. one
+ * counting its calls, so the sorts take the same fast paths for it as for
+ * lessThan: sorting network blocks, radix sorts and specialized sorts. Those
+ * paths do not call compare. Only one function can be declared at a time.
+ * \param compare The ascending compare function, NULL to clear the declaration
+ */
+void integerCompareSetAscending(IntegerCompareFunction *compare);
+
+/**
+ * \brief Tell if a compare function is lessThan or the one declared with
+ * integerCompareSetAscending
+ */
+bool integerCompareIsAscending(IntegerCompareFunction *compare);
+
+/**
+ * Compare function for descending order
+ */
+bool greaterThan(int32_t a, int32_t b);
+
 #endif //__MERGE_SORT_H__
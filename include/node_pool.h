@@ -0,0 +1,69 @@
+/**
+ * A slab allocator for list nodes and their payloads
+ */
+#ifndef __NODE_POOL_H__
+#define __NODE_POOL_H__
+#include <stddef.h>
+#include "list.h"
+
+struct NodePoolBlock;
+
+/**
+ * \brief A pool of list nodes carved from large blocks of memory.
+ * Every slot holds a ListNode followed by its payload, so a node and its value
+ * are reserved at once and live in the same cache line. Freed nodes go to a
+ * freelist to be reused, and all of them are released at once by destroying the pool.
+ */
+struct NodePool {
+    size_t payloadSize;            /* Size of the value stored next to every node */
+    size_t slotSize;               /* Size of a node and its payload, properly aligned */
+    size_t slotsPerBlock;          /* Amount of nodes carved from every new block */
+    size_t blockSlots;             /* Amount of nodes carved from the current block */
+    size_t usedSlots;              /* Slots already carved from the current block */
+    size_t blockCount;             /* Amount of blocks reserved */
+    struct NodePoolBlock *blocks;  /* Reserved blocks, the first one is the current block */
+    struct ListNode *freeList;     /* Released nodes, linked through next */
+};
+
+/**
+ * \brief Creates a pool of nodes
+ * \param payloadSize   Size of the value stored with every node, it can be 0.
+ * \param slotsPerBlock Amount of nodes reserved at once in every block
+ * \return A pointer to the newly created pool.
+ */
+struct NodePool *nodePoolCreate(size_t payloadSize, size_t slotsPerBlock);
+
+/**
+ * \brief Creates a pool of nodes and reserves its first block at once, sized
+ * for a known amount of nodes. The next blocks are sized for slotsPerBlock.
+ * \param payloadSize     Size of the value stored with every node, it can be 0.
+ * \param firstBlockSlots Amount of nodes reserved in the first block, 0 to reserve it on the first allocation
+ * \param slotsPerBlock   Amount of nodes reserved at once in every later block
+ * \return A pointer to the newly created pool.
+ */
+struct NodePool *nodePoolCreateWithFirstBlock(size_t payloadSize, size_t firstBlockSlots, size_t slotsPerBlock);
+
+/**
+ * \brief Get a node from the pool.
+ * The node and its payload are set to 0, the value of the node points to
+ * its payload or is NULL if the pool has no payload.
+ * \param pool The pool to take the node from
+ * \return A pointer to the node.
+ */
+struct ListNode *nodePoolAlloc(struct NodePool *pool);
+
+/**
+ * \brief Return a node to the pool so it can be reused.
+ * \param pool The pool the node was taken from
+ * \param node The node to be released
+ */
+void nodePoolFree(struct NodePool *pool, struct ListNode *node);
+
+/**
+ * \brief Frees all the memory of a pool in O(blocks), including all the nodes
+ * taken from it.
+ * \param pool The pool to be freed
+ */
+void nodePoolDestroy(struct NodePool *pool);
+
+#endif //__NODE_POOL_H__
@@ -0,0 +1,81 @@
+/**
+ * Multi-threaded sorting algorithms for lists and arrays of integers
+ */
+#ifndef __PARALLEL_SORT_H__
+#define __PARALLEL_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+#include "array_sort.h"
+
+/* Inputs smaller than this are sorted in the calling thread */
+#define PARALLEL_SORT_DEFAULT_CUTOFF 16384
+
+/**
+ * \brief Amount of threads used by default, the number of online processors.
+ */
+size_t parallelSortDefaultThreads(void);
+
+/**
+ * \brief A parallel MergeSort for integer lists.
+ * The list is split in up to threads sublists of roughly equal size, each
+ * worker thread sorts its own sublist with integerListMergeSortInPlace, then
+ * the sorted sublists are merged in pairs by a tree of parallel merges. The
+ * sort is stable and only relinks the nodes.
+ * \param list         The list to be sorted
+ * \param compare      Function that tells if a should be located before b
+ * \param threads      Amount of threads to use, 0 uses parallelSortDefaultThreads
+ * \param serialCutoff Minimum amount of elements given to a thread
+ */
+void integerListParallelMergeSort(struct List *list, IntegerCompareFunction compare, size_t threads, size_t serialCutoff);
+
+/**
+ * \brief integerListParallelMergeSort with the default amount of threads and
+ * cutoff, it can be used as a SortFunction.
+ */
+void integerListParallelSort(struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief A parallel MergeSort for arrays of integers.
+ * The array is split in up to threads chunks sorted by worker threads with
+ * integerArrayMergeSort. The chunks are then merged in pairs, every level of the
+ * merge tree splits the output evenly between all the threads, finding the
+ * matching input positions with a binary search (merge path). The sort is stable.
+ * \param values       Array to be sorted
+ * \param count        Amount of elements in the array
+ * \param compare      Function that tells if a should be located before b
+ * \param threads      Amount of threads to use, 0 uses parallelSortDefaultThreads
+ * \param serialCutoff Minimum amount of elements given to a thread
+ * \param scratch      Scratch buffer to be used, if NULL a temporary one is reserved.
+ */
+void integerArrayParallelMergeSort(int32_t *values, size_t count, IntegerCompareFunction compare,
+                                   size_t threads, size_t serialCutoff, struct ArraySortScratch *scratch);
+
+/**
+ * \brief A parallel LSD radix sort for arrays of integers, ascending and stable.
+ * The array is split in up to threads contiguous chunks. Every pass counts the
+ * digits of each chunk in parallel, a prefix sum over the buckets and chunks gives
+ * every chunk its own output offsets, then the chunks are scattered in parallel
+ * through per bucket write combining buffers. Passes whose digit is shared by all
+ * the values are skipped.
+ * \param values       Array to be sorted
+ * \param count        Amount of elements in the array
+ * \param threads      Amount of threads to use, 0 uses parallelSortDefaultThreads
+ * \param serialCutoff Minimum amount of elements given to a thread
+ * \param scratch      Scratch buffer to be used, if NULL a temporary one is reserved.
+ */
+void integerArrayParallelRadixSort(int32_t *values, size_t count, size_t threads, size_t serialCutoff,
+                                   struct ArraySortScratch *scratch);
+
+/**
+ * \brief Ascending sort of an integer list with integerArrayParallelRadixSort.
+ * The values are gathered into an array, sorted and written back in list order.
+ * readOnly lists are sorted by relinking with integerListGatherSort instead.
+ * \param list    The list to be sorted
+ * \param threads Amount of threads to use, 0 uses parallelSortDefaultThreads
+ * \return        RET_OK, or RET_FAIL if list is NULL.
+ */
+enum ListReturnType integerListParallelRadixSort(struct List *list, size_t threads);
+
+#endif //__PARALLEL_SORT_H__
@@ -0,0 +1,70 @@
+/**
+ * Partial sorting and selection for integer lists and arrays
+ *  Only the first k elements of the sorted order are computed, in O(n log k)
+ *  time, or only the k-th element is found, in expected O(n) time. The
+ *  remaining elements are left unsorted.
+ */
+#ifndef __PARTIAL_SORT_H__
+#define __PARTIAL_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+
+/**
+ * \brief Move the first k elements of the sorted order to the front of the list.
+ * The list is scanned once keeping the best k nodes in a bounded heap. Those
+ * nodes are relinked in order at the head of the list, the other nodes follow
+ * them in their original relative order. Equal values keep their order, so the
+ * front of the list matches the one of a stable full sort. Use greaterThan as
+ * compare function to take the largest k elements.
+ * \param list    The list to be partially sorted
+ * \param k       Amount of elements to be sorted, the whole list is sorted when k >= count
+ * \param compare Function that tells if a should be located before b
+ * \return        RET_OK on success, RET_FAIL if list is NULL.
+ */
+enum ListReturnType integerListPartialSort(struct List *list, size_t k, IntegerCompareFunction compare);
+
+/**
+ * \brief Copy the first k values of the sorted order of a list to an array,
+ * without modifying the list. It costs O(n log k) time and O(k) memory.
+ * \param list    The list to be read
+ * \param k       Amount of values wanted
+ * \param compare Function that tells if a should be located before b
+ * \param output  Array of at least k elements receiving the values in order
+ * \return        Amount of values written, the smallest of k and the list size.
+ */
+size_t integerListTopK(const struct List *list, size_t k, IntegerCompareFunction compare, int32_t *output);
+
+/**
+ * \brief Find the k-th element of the sorted order of a list (counting from 0)
+ * and partition the list around it, like a quickselect.
+ * Every round picks a pivot node and splits the remaining nodes in 3 chains:
+ * before, equal to and after the pivot. Only the chain holding position k is
+ * partitioned again, so the expected time is O(n). At the end the list holds
+ * the nodes placed before the k-th element, then the k-th node, then the nodes
+ * not placed before it. Nodes are only relinked, in their relative order.
+ * \param list    The list to be partitioned
+ * \param k       Position of the wanted element in the sorted order
+ * \param compare Function that tells if a should be located before b
+ * \param result  Receives the k-th value, can be NULL
+ * \return        RET_OK on success, RET_FAIL if list is NULL or k is out of range.
+ */
+enum ListReturnType integerListSelect(struct List *list, size_t k, IntegerCompareFunction compare, int32_t *result);
+
+/**
+ * \brief Find the k-th element of the sorted order of an array (counting from 0)
+ * and partition the array around it, like C++ nth_element.
+ * A quickselect with three way partitioning, so repeated values are handled in
+ * linear time. Afterwards values[k] holds the k-th element, the values before
+ * it are not placed after it and the values after it are not placed before it.
+ * \param values  Array to be partitioned
+ * \param count   Amount of elements in the array
+ * \param k       Position of the wanted element in the sorted order
+ * \param compare Function that tells if a should be located before b
+ * \param result  Receives the k-th value, can be NULL
+ * \return        RET_OK on success, RET_FAIL if values is NULL or k is out of range.
+ */
+enum ListReturnType integerArraySelect(int32_t *values, size_t count, size_t k, IntegerCompareFunction compare, int32_t *result);
+
+#endif //__PARTIAL_SORT_H__
@@ -0,0 +1,146 @@
+/**
+ * Template of a stable LSD radix sort specialized at compile time
+ *  Every inclusion instantiates the steps of a radix sort for one element type,
+ *  sorting by an unsigned key with the same order as the elements one byte at a
+ *  time. The digits of all the passes are counted in a single read and passes
+ *  whose digit all the keys share are skipped. Define before including it:
+ *
+ *   RADIX_NAME       Prefix of the generated functions, e.g. int32
+ *   RADIX_TYPE       Type of the elements, e.g. int32_t
+ *   RADIX_KEY(x)     Unsigned key extracted from an element, e.g. an int32_t
+ *                    with its sign bit flipped so the negative values go first.
+ *   RADIX_KEY_BITS   Optional, bits of the key, 32 by default.
+ *   RADIX_SCOPE      Optional, storage of RADIX_NAMERadixSort, defaults
+ *                    to static inline, define it empty to export it.
+ *
+ *  Generated functions, the histograms have RADIX_TEMPLATE_BUCKETS entries:
+ *   size_t RADIX_NAMERadixDigit(RADIX_TYPE x, int pass);
+ *   void RADIX_NAMERadixCount(const RADIX_TYPE *values, size_t count, size_t histograms[][RADIX_TEMPLATE_BUCKETS]);
+ *   void RADIX_NAMERadixCountPass(const RADIX_TYPE *values, size_t count, int pass, size_t *histogram);
+ *   size_t RADIX_NAMERadixOffsets(size_t *histogram, size_t offset);
+ *   void RADIX_NAMERadixScatter(const RADIX_TYPE *src, RADIX_TYPE *dst, size_t count, int pass, size_t *offsets);
+ *   RADIX_TYPE *RADIX_NAMERadixSort(RADIX_TYPE *values, RADIX_TYPE *buffer, size_t count);
+ *
+ *  All the macros but the RADIX_TEMPLATE_ constants are undefined at the end,
+ *  so the header can be included again.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "sort_stats.h"
+
+#ifndef RADIX_NAME
+#error "RADIX_NAME must be defined before including radix_template.h"
+#endif
+#ifndef RADIX_TYPE
+#error "RADIX_TYPE must be defined before including radix_template.h"
+#endif
+#ifndef RADIX_KEY
+#error "RADIX_KEY must be defined before including radix_template.h"
+#endif
+#ifndef RADIX_KEY_BITS
+#define RADIX_KEY_BITS 32
+#endif
+#ifndef RADIX_SCOPE
+#define RADIX_SCOPE static inline
+#endif
+
+/* Bits sorted on every pass */
+#ifndef RADIX_TEMPLATE_BITS
+#define RADIX_TEMPLATE_BITS 8
+#define RADIX_TEMPLATE_BUCKETS (1 << RADIX_TEMPLATE_BITS)
+#endif
+
+#define RADIX_KEY_PASSES (RADIX_KEY_BITS / RADIX_TEMPLATE_BITS)
+#define RADIX_TEMPLATE_CONCAT_(a, b) a ## b
+#define RADIX_TEMPLATE_CONCAT(a, b) RADIX_TEMPLATE_CONCAT_(a, b)
+#define RADIX_FN(suffix) RADIX_TEMPLATE_CONCAT(RADIX_NAME, suffix)
+
+/**
+ * \brief Digit of an element sorted by a pass
+ */
+static inline size_t RADIX_FN(RadixDigit)(RADIX_TYPE x, int pass){
+    return (size_t) ((RADIX_KEY(x) >> (pass * RADIX_TEMPLATE_BITS)) & (RADIX_TEMPLATE_BUCKETS - 1));
+}
+
+/**
+ * \brief Count the digits of every pass in a single read of the elements.
+ * The histograms must be cleared by the caller.
+ */
+static inline void RADIX_FN(RadixCount)(const RADIX_TYPE *values, size_t count,
+                                        size_t histograms[][RADIX_TEMPLATE_BUCKETS]){
+    for(size_t i = 0; i < count; i++){
+        for(int pass = 0; pass < RADIX_KEY_PASSES; pass++){
+            histograms[pass][RADIX_FN(RadixDigit)(values[i], pass)]++;
+        }
+    }
+}
+
+/**
+ * \brief Count the digits of a single pass, the histogram must be cleared by the caller.
+ */
+static inline void RADIX_FN(RadixCountPass)(const RADIX_TYPE *values, size_t count, int pass, size_t *histogram){
+    for(size_t i = 0; i < count; i++){
+        histogram[RADIX_FN(RadixDigit)(values[i], pass)]++;
+    }
+}
+
+/**
+ * \brief Turn a histogram into the starting offset of every bucket
+ * \return The offset after the last bucket
+ */
+static inline size_t RADIX_FN(RadixOffsets)(size_t *histogram, size_t offset){
+    for(size_t bucket = 0; bucket < RADIX_TEMPLATE_BUCKETS; bucket++){
+        size_t amount = histogram[bucket];
+        histogram[bucket] = offset;
+        offset += amount;
+    }
+    return offset;
+}
+
+/**
+ * \brief Move the elements to the offsets of their buckets in order, so the pass is stable
+ */
+static inline void RADIX_FN(RadixScatter)(const RADIX_TYPE *src, RADIX_TYPE *dst, size_t count, int pass,
+                                          size_t *offsets){
+    for(size_t i = 0; i < count; i++){
+        dst[offsets[RADIX_FN(RadixDigit)(src[i], pass)]++] = src[i];
+    }
+}
+
+/**
+ * \brief Stable LSD radix sort, buffer holds count elements.
+ * \return The array holding the result, values or buffer.
+ */
+RADIX_SCOPE RADIX_TYPE *RADIX_FN(RadixSort)(RADIX_TYPE *values, RADIX_TYPE *buffer, size_t count){
+    if(count == 0) return values;
+    size_t histograms[RADIX_KEY_PASSES][RADIX_TEMPLATE_BUCKETS];
+    memset(histograms, 0, sizeof(histograms));
+    RADIX_FN(RadixCount)(values, count, histograms);
+
+    RADIX_TYPE *src = values;
+    RADIX_TYPE *dst = buffer;
+    for(int pass = 0; pass < RADIX_KEY_PASSES; pass++){
+        /* All the keys share this digit, this pass would not change the order */
+        if(histograms[pass][RADIX_FN(RadixDigit)(src[0], pass)] == count) continue;
+
+        RADIX_FN(RadixOffsets)(histograms[pass], 0);
+        SORT_STATS_ADD(mergePasses, 1);
+        SORT_STATS_ADD(nodeMoves, count);
+        RADIX_FN(RadixScatter)(src, dst, count, pass, histograms[pass]);
+        RADIX_TYPE *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    return src;
+}
+
+#undef RADIX_FN
+#undef RADIX_TEMPLATE_CONCAT
+#undef RADIX_TEMPLATE_CONCAT_
+#undef RADIX_KEY_PASSES
+#undef RADIX_NAME
+#undef RADIX_TYPE
+#undef RADIX_KEY
+#undef RADIX_KEY_BITS
+#undef RADIX_SCOPE
@@ -0,0 +1,53 @@
+/**
+ * Stable sort of lists of records by a key extracted from every value
+ *  The node values can be any record, a key function reads its key into a
+ *  struct RecordKey. The keys are gathered with their nodes into a contiguous
+ *  buffer, sorted there and the nodes are relinked in order, so the records
+ *  move with their keys without being copied. Numeric keys are encoded as
+ *  unsigned integers with the same order and sorted with a LSD radix sort,
+ *  byte string keys with a merge sort comparing them with memcmp.
+ */
+#ifndef __RECORD_SORT_H__
+#define __RECORD_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+
+/* Lists with less elements than this are sorted with the merge sort for any key type */
+#define RECORD_SORT_RADIX_MIN_SIZE 64
+
+enum RecordKeyType {
+    RECORD_KEY_INT64,  /* Signed key in RecordKey.int64 */
+    RECORD_KEY_UINT64, /* Unsigned key in RecordKey.uint64 */
+    RECORD_KEY_DOUBLE, /* Key in RecordKey.real, total order: -NaN, -inf, ..., -0, +0, ..., +inf, +NaN */
+    RECORD_KEY_BYTES   /* size bytes at RecordKey.bytes compared with memcmp, a prefix goes first */
+};
+
+struct RecordKey {
+    int64_t int64;
+    uint64_t uint64;
+    double real;
+    const void *bytes;  /* Must stay valid until the sort ends, usually points into the record */
+    size_t size;
+};
+
+/**
+ * \brief Data type for the functions reading the key of a record
+ * \param value The value of a node of the list
+ * \param key   Receives the key, only the fields of the key type must be set
+ */
+typedef void RecordKeyFunction(const void *value, struct RecordKey *key);
+
+/**
+ * \brief Stable sort of a list in ascending order of the keys of its values.
+ * Only the nodes are relinked, the values are not modified. The list is marked
+ * sorted with the key function as order, but the list is sorted again on every
+ * call, as the keys can be changed inside the records.
+ * \param list The list to be sorted
+ * \param type The type of the keys
+ * \param key  Function reading the key of a value
+ * \return     RET_OK on success, RET_FAIL if list or key is NULL.
+ */
+enum ListReturnType listRecordSort(struct List *list, enum RecordKeyType type, RecordKeyFunction *key);
+
+#endif //__RECORD_SORT_H__
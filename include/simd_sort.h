@@ -0,0 +1,55 @@
+/**
+ * Sorting network kernels for small blocks of integers
+ *  The kernels sort up to SIMD_SORT_BLOCK_SIZE int32_t values in ascending order
+ *  using bitonic sorting networks on SSE4.1 or AVX2 registers. The best kernel
+ *  supported by the processor is selected at runtime, with a scalar fallback.
+ */
+#ifndef __SIMD_SORT_H__
+#define __SIMD_SORT_H__
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Largest block sorted by the kernels */
+#define SIMD_SORT_BLOCK_SIZE 64
+
+enum SimdSortKernel {
+    SIMD_SORT_SCALAR,   /* Insertion sort, available everywhere */
+    SIMD_SORT_SSE41,    /* 4 lanes networks, blocks of 4, 8, 16 and 64 values */
+    SIMD_SORT_AVX2      /* 8 lanes networks, blocks of 8, 16 and 64 values */
+};
+
+/**
+ * \brief Kernel used by int32SortBlock, the best one supported by the processor
+ * unless another one was set with simdSortSetKernel. The best kernel is
+ * selected once, by the first call from any thread.
+ */
+enum SimdSortKernel simdSortKernel(void);
+
+/**
+ * \brief Tells if the processor supports a kernel
+ */
+bool simdSortKernelSupported(enum SimdSortKernel kernel);
+
+/**
+ * \brief Select the kernel used by int32SortBlock, mostly useful for testing.
+ * \param kernel The kernel to be used
+ * \return       true if the kernel is supported and it was selected.
+ */
+bool simdSortSetKernel(enum SimdSortKernel kernel);
+
+/**
+ * \brief Name of a kernel, to be printed
+ */
+const char *simdSortKernelName(enum SimdSortKernel kernel);
+
+/**
+ * \brief Sort a small block of integers in ascending order.
+ * The block is padded up to the next network size (8, 16 or 64 values) and
+ * sorted in registers without any compare function call or branch.
+ * \param values Block to be sorted
+ * \param count  Amount of values, up to SIMD_SORT_BLOCK_SIZE
+ */
+void int32SortBlock(int32_t *values, size_t count);
+
+#endif //__SIMD_SORT_H__
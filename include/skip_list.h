@@ -0,0 +1,69 @@
+/**
+ * Skip list index over a sorted integer list
+ *  The index keeps a tower of forward links for every node of a List, so sorted
+ *  insertion, search, lower bound and removal run in expected O(log n). The List
+ *  itself stays a regular sorted doubly linked list, so listForEach and the other
+ *  list functions keep working on it.
+ */
+#ifndef __SKIP_LIST_H__
+#define __SKIP_LIST_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+
+/* Highest tower of the index, enough for 4^32 nodes */
+#define SKIP_LIST_MAX_LEVEL 32
+
+struct SkipListEntry;
+
+struct SkipListIndex {
+    struct List *list;               /* Indexed list, kept sorted by compare */
+    IntegerCompareFunction *compare; /* Order of the list */
+    struct SkipListEntry *head;      /* Sentinel entry with a tower of SKIP_LIST_MAX_LEVEL links */
+    size_t level;                    /* Levels in use */
+    uint64_t random;                 /* State of the generator of tower heights */
+};
+
+/**
+ * \brief Creates an index over a list, sorting the list first if it is not
+ * already sorted by compare. Building the index takes O(n).
+ * While the index exists the list should only be modified through it.
+ * \param list    The list to be indexed
+ * \param compare Function that tells if a should be located before b
+ * \return        A pointer to the created index, NULL if list is NULL.
+ */
+struct SkipListIndex *skipListIndexCreate(struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief Frees the index, the list and its nodes are kept
+ */
+void skipListIndexDestroy(struct SkipListIndex *index);
+
+/**
+ * \brief Insert a value keeping the list sorted, after the values equal to it.
+ * \param index The index of the list
+ * \param value Value to be inserted
+ * \return      The node created for the value, NULL on failure or if the list is readOnly.
+ */
+struct ListNode *skipListIndexInsert(struct SkipListIndex *index, int32_t value);
+
+/**
+ * \brief Find the first node of the list that is not placed before value
+ * \return The node or NULL if all the nodes are placed before value.
+ */
+struct ListNode *skipListIndexLowerBound(const struct SkipListIndex *index, int32_t value);
+
+/**
+ * \brief Find the first node of the list holding a value equal to value
+ * \return The node or NULL if the value is not in the list.
+ */
+struct ListNode *skipListIndexFind(const struct SkipListIndex *index, int32_t value);
+
+/**
+ * \brief Remove and free the first node holding a value equal to value
+ * \return RET_OK if a node was removed or RET_FAIL if the value is not in the list.
+ */
+enum ListReturnType skipListIndexRemove(struct SkipListIndex *index, int32_t value);
+
+#endif //__SKIP_LIST_H__
@@ -0,0 +1,70 @@
+/**
+ * Optional statistics of the sorting algorithms
+ *  The counters are only updated when the library is built with MERGESORT_STATS
+ *  defined (make STATS=1), otherwise the instrumentation compiles to nothing.
+ *  The counters are kept per thread, the parallel sorts add the counters of
+ *  their worker threads to the thread that called them.
+ */
+#ifndef __SORT_STATS_H__
+#define __SORT_STATS_H__
+#include <stdbool.h>
+#include <stdint.h>
+
+struct SortStats {
+    uint64_t comparisons;      /* Calls to the compare function */
+    uint64_t nodeMoves;        /* Nodes or values moved to a new position, a spliced segment counts once */
+    uint64_t merges;           /* Merges of 2 sorted runs */
+    uint64_t mergePasses;      /* Passes over the whole input of the bottom up and radix sorts */
+    uint64_t allocations;      /* Calls to xzalloc */
+    uint64_t allocatedBytes;   /* Bytes reserved with xzalloc */
+    uint64_t splitNs;          /* Time splitting the input in runs */
+    uint64_t mergeNs;          /* Time in the merge passes */
+    uint64_t copyBackNs;       /* Time moving the result back to the input */
+};
+
+/**
+ * \brief Tells if the library was built with the statistics enabled
+ */
+bool sortStatsEnabled(void);
+
+/**
+ * \brief Set all the counters of the calling thread to 0
+ */
+void sortStatsReset(void);
+
+/**
+ * \brief Read the counters of the calling thread
+ * \param stats Output for the counters, all 0 if the statistics are disabled
+ */
+void sortStatsGet(struct SortStats *stats);
+
+/**
+ * \brief Add a set of counters to the counters of the calling thread
+ * \param stats Counters to be added
+ */
+void sortStatsAccumulate(const struct SortStats *stats);
+
+#ifdef MERGESORT_STATS
+
+extern _Thread_local struct SortStats sortStatsCurrent;
+
+/**
+ * \brief Monotonic time in nanoseconds used to measure the phases
+ */
+uint64_t sortStatsNowNs(void);
+
+#define SORT_STATS_ADD(field, amount) (sortStatsCurrent.field += (amount))
+#define SORT_STATS_TIMER_START(timer) uint64_t timer = sortStatsNowNs()
+#define SORT_STATS_TIMER_STOP(field, timer) (sortStatsCurrent.field += sortStatsNowNs() - (timer))
+#define SORT_COMPARE(compare, a, b) (sortStatsCurrent.comparisons++, (compare)((a), (b)))
+
+#else
+
+#define SORT_STATS_ADD(field, amount) ((void) 0)
+#define SORT_STATS_TIMER_START(timer) ((void) 0)
+#define SORT_STATS_TIMER_STOP(field, timer) ((void) 0)
+#define SORT_COMPARE(compare, a, b) ((compare)((a), (b)))
+
+#endif //MERGESORT_STATS
+
+#endif //__SORT_STATS_H__
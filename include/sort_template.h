@@ -0,0 +1,216 @@
+/**
+ * Template of a stable merge sort specialized at compile time
+ *  Every inclusion instantiates a sort for one element type with the comparison
+ *  written as an expression, so it gets inlined instead of being called through
+ *  an IntegerCompareFunction pointer. Define before including it:
+ *
+ *   SORT_NAME          Prefix of the generated functions, e.g. int32Ascending
+ *   SORT_TYPE          Type of the elements, e.g. int32_t
+ *   SORT_LESS(a, b)    Optional, tells if element a goes before element b.
+ *                      Defaults to comparing SORT_KEY(a) < SORT_KEY(b).
+ *   SORT_KEY(x)        Optional, key extracted from an element, defaults to x.
+ *   SORT_SCOPE         Optional, storage of the generated functions, defaults
+ *                      to static, define it empty to export them.
+ *   SORT_LIST_VALUE(n) Optional, extracts a SORT_TYPE from a struct ListNode.
+ *                      When defined a sort relinking the nodes of a List is
+ *                      generated as well.
+ *   SORT_LIST_ORDER    Optional, compare function matching SORT_LESS, recorded
+ *                      as the order of the sorted list, see listMarkSorted.
+ *
+ *  Generated functions:
+ *   void SORT_NAMESort(SORT_TYPE *values, size_t count, SORT_TYPE *scratch);
+ *   void SORT_NAMEListSort(struct List *list);   (with SORT_LIST_VALUE)
+ *
+ *  All the macros are undefined at the end, so the header can be included again.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+#include "utils.h"
+
+#ifndef SORT_NAME
+#error "SORT_NAME must be defined before including sort_template.h"
+#endif
+#ifndef SORT_TYPE
+#error "SORT_TYPE must be defined before including sort_template.h"
+#endif
+#ifndef SORT_KEY
+#define SORT_KEY(x) (x)
+#endif
+#ifndef SORT_LESS
+#define SORT_LESS(a, b) (SORT_KEY(a) < SORT_KEY(b))
+#endif
+#ifndef SORT_SCOPE
+#define SORT_SCOPE static
+#endif
+
+#define SORT_TEMPLATE_CONCAT_(a, b) a ## b
+#define SORT_TEMPLATE_CONCAT(a, b) SORT_TEMPLATE_CONCAT_(a, b)
+#define SORT_FN(suffix) SORT_TEMPLATE_CONCAT(SORT_NAME, suffix)
+
+/* Blocks of this size are sorted with insertion sort before the merge passes */
+#ifndef SORT_TEMPLATE_BLOCK_SIZE
+#define SORT_TEMPLATE_BLOCK_SIZE 16
+#endif
+
+static inline void SORT_FN(InsertionSort)(SORT_TYPE *values, size_t count){
+    for(size_t i = 1; i < count; i++){
+        SORT_TYPE value = values[i];
+        size_t j = i;
+        while((j > 0) && SORT_LESS(value, values[j - 1])){
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+static inline void SORT_FN(Merge)(SORT_TYPE *left, size_t leftCount, SORT_TYPE *right, size_t rightCount,
+                                  SORT_TYPE *dst){
+    size_t i = 0;
+    size_t j = 0;
+    while((i < leftCount) && (j < rightCount)){
+        if(SORT_LESS(right[j], left[i])){
+            *dst++ = right[j++];
+        } else {
+            *dst++ = left[i++];
+        }
+    }
+    memcpy(dst, left + i, (leftCount - i) * sizeof(SORT_TYPE));
+    dst += leftCount - i;
+    memcpy(dst, right + j, (rightCount - j) * sizeof(SORT_TYPE));
+}
+
+/**
+ * \brief Stable bottom up merge sort, scratch holds count elements or is NULL
+ * to reserve a temporary buffer.
+ */
+SORT_SCOPE void SORT_FN(Sort)(SORT_TYPE *values, size_t count, SORT_TYPE *scratch){
+    for(size_t i = 0; i < count; i += SORT_TEMPLATE_BLOCK_SIZE){
+        size_t blockCount = (count - i < SORT_TEMPLATE_BLOCK_SIZE) ? count - i : SORT_TEMPLATE_BLOCK_SIZE;
+        SORT_FN(InsertionSort)(values + i, blockCount);
+    }
+    if(count <= SORT_TEMPLATE_BLOCK_SIZE) return;
+
+    SORT_TYPE *ownScratch = NULL;
+    if(scratch == NULL){
+        ownScratch = (SORT_TYPE *) xzalloc(count, sizeof(SORT_TYPE));
+        scratch = ownScratch;
+    }
+    SORT_TYPE *src = values;
+    SORT_TYPE *dst = scratch;
+    for(size_t width = SORT_TEMPLATE_BLOCK_SIZE; width < count; width *= 2){
+        for(size_t i = 0; i < count; i += 2 * width){
+            size_t leftCount = (count - i < width) ? count - i : width;
+            size_t rightCount = (count - i - leftCount < width) ? count - i - leftCount : width;
+            SORT_FN(Merge)(src + i, leftCount, src + i + leftCount, rightCount, dst + i);
+        }
+        SORT_TYPE *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    /* An odd amount of passes leaves the result in the scratch buffer */
+    if(src != values){
+        memcpy(values, src, count * sizeof(SORT_TYPE));
+    }
+    free(ownScratch);
+}
+
+#ifdef SORT_LIST_VALUE
+
+#define SORT_LIST_LESS(a, b) SORT_LESS(SORT_LIST_VALUE(a), SORT_LIST_VALUE(b))
+
+/**
+ * \brief Stable merge of 2 NULL terminated chains of nodes by relinking them,
+ * prev links are fixed on the way. Returns the head, when tail is not NULL it
+ * receives the tail of the result.
+ */
+static inline struct ListNode *SORT_FN(MergeChains)(struct ListNode *a, struct ListNode *b, struct ListNode **tail){
+    struct ListNode dummy;
+    struct ListNode *last = &dummy;
+    while((a != NULL) && (b != NULL)){
+        struct ListNode *next;
+        if(SORT_LIST_LESS(b, a)){
+            next = b;
+            b = b->next;
+        } else {
+            next = a;
+            a = a->next;
+        }
+        last->next = next;
+        next->prev = last;
+        last = next;
+    }
+    struct ListNode *rest = (a != NULL) ? a : b;
+    last->next = rest;
+    if(rest != NULL) rest->prev = last;
+    if(tail != NULL){
+        while(last->next != NULL) last = last->next;
+        *tail = last;
+    }
+    dummy.next->prev = NULL;
+    return dummy.next;
+}
+
+/**
+ * \brief Stable in place merge sort of a List, only the links are modified.
+ * The nodes are fed one by one into bins of 2^i sorted nodes, like a binary counter.
+ */
+SORT_SCOPE void SORT_FN(ListSort)(struct List *list){
+    if((list == NULL) || (list->count <= 1)) return;
+
+    struct ListNode *bins[sizeof(size_t) * 8] = {0};
+    size_t usedBins = 0;
+    struct ListNode *tail = NULL;
+    struct ListNode *node = list->head;
+    while(node != NULL){
+        struct ListNode *next = node->next;
+        node->next = NULL;
+        node->prev = NULL;
+        struct ListNode *carry = node;
+        size_t i = 0;
+        while(bins[i] != NULL){
+            /* bins[i] holds older nodes, keep it first for stability */
+            carry = SORT_FN(MergeChains)(bins[i], carry, NULL);
+            bins[i] = NULL;
+            i++;
+        }
+        bins[i] = carry;
+        if(i >= usedBins) usedBins = i + 1;
+        node = next;
+    }
+
+    /* Only the final merges look for the tail of the list */
+    struct ListNode *result = NULL;
+    for(size_t i = 0; i < usedBins; i++){
+        if(bins[i] == NULL) continue;
+        result = (result == NULL) ? bins[i] : SORT_FN(MergeChains)(bins[i], result, &tail);
+    }
+    if(tail == NULL){
+        tail = result;
+        while(tail->next != NULL) tail = tail->next;
+    }
+    list->head = result;
+    list->tail = tail;
+#ifdef SORT_LIST_ORDER
+    listMarkSorted(list, list->count, (const void *) SORT_LIST_ORDER);
+#else
+    list->sortedCount = 0;
+#endif
+}
+
+#undef SORT_LIST_LESS
+#endif //SORT_LIST_VALUE
+
+#undef SORT_FN
+#undef SORT_TEMPLATE_CONCAT
+#undef SORT_TEMPLATE_CONCAT_
+#undef SORT_NAME
+#undef SORT_TYPE
+#undef SORT_KEY
+#undef SORT_LESS
+#undef SORT_SCOPE
+#undef SORT_LIST_VALUE
+#undef SORT_LIST_ORDER
@@ -0,0 +1,83 @@
+/**
+ * Set operations over sorted integer lists
+ *  The operations walk both lists once and relink their nodes into the result,
+ *  values are only copied in the case described below. Long stretches without
+ *  matches are found with integerListGallop and spliced or dropped at once.
+ *  Dropped nodes are freed with listNodeFree on the list that owned them.
+ *
+ *  The lists are handled as sorted multisets, like the set algorithms of the
+ *  C++ standard library: a value held m times by list and n times by other is
+ *  kept max(m, n) times by the union, min(m, n) times by the intersection and
+ *  m - n times by the difference. Two values are equal when neither of them is
+ *  placed before the other by compare. Lists that are not sorted by compare are
+ *  sorted first with integerListNaturalMergeSort.
+ *
+ *  The nodes of other are only linked into list when both lists free them the
+ *  same way: no node pool and the same freeNode function. Otherwise, as with
+ *  pooled lists, bulk lists or views, the values kept from other are copied
+ *  into nodes created by integerListNodeCreateFor on list.
+ */
+#ifndef __SORTED_SET_H__
+#define __SORTED_SET_H__
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+#include "merge_sort.h"
+
+/**
+ * \brief Data type for the callback of integerListMergeJoin
+ * \param value      Value of a node of list
+ * \param otherValue Value equal to it of a node of other
+ * \param userData   Pointer given to integerListMergeJoin
+ * \return           true to continue the join, false to stop it.
+ */
+typedef bool ListJoinCallback(void *value, void *otherValue, void *userData);
+
+/**
+ * \brief Remove the repeated values of a list, the first node of every group
+ * of equal values is kept and the rest are freed.
+ * \param list    The list to be deduplicated
+ * \param compare Function that tells if a should be located before b
+ * \return        RET_OK, or RET_FAIL if list is NULL.
+ */
+enum ListReturnType integerListUnique(struct List *list, IntegerCompareFunction compare);
+
+/**
+ * \brief Union of 2 sorted lists into list. The nodes of other are merged in,
+ * on ties the nodes of list go first and the matching nodes of other are freed.
+ * other is left empty.
+ * \return RET_OK, or RET_FAIL if list or other is NULL, they are the same list,
+ *         or the values of other would have to be copied into a readOnly list.
+ */
+enum ListReturnType integerListUnion(struct List *list, struct List *other, IntegerCompareFunction compare);
+
+/**
+ * \brief Intersection of 2 sorted lists into list. The nodes of list without
+ * a match and all the nodes of other are freed, other is left empty.
+ * \return RET_OK, or RET_FAIL if list or other is NULL or they are the same list.
+ */
+enum ListReturnType integerListIntersection(struct List *list, struct List *other, IntegerCompareFunction compare);
+
+/**
+ * \brief Difference of 2 sorted lists into list. The nodes of list matched by
+ * a node of other and all the nodes of other are freed, other is left empty.
+ * \return RET_OK, or RET_FAIL if list or other is NULL or they are the same list.
+ */
+enum ListReturnType integerListDifference(struct List *list, struct List *other, IntegerCompareFunction compare);
+
+/**
+ * \brief Merge join of 2 sorted lists. The callback is called for every pair of
+ * equal values, a group of m equal values in list and n in other gives m * n
+ * calls, in list order and then other order. The links of the lists are not
+ * modified, unless they have to be sorted first.
+ * \param list     First list to be joined
+ * \param other    Second list to be joined
+ * \param compare  Function that tells if a should be located before b
+ * \param callback Function called for every pair of equal values
+ * \param userData Pointer passed to the callback
+ * \return         RET_OK, or RET_FAIL if list, other or callback is NULL.
+ */
+enum ListReturnType integerListMergeJoin(struct List *list, struct List *other, IntegerCompareFunction compare,
+                                         ListJoinCallback callback, void *userData);
+
+#endif //__SORTED_SET_H__
@@ -0,0 +1,71 @@
+/**
+ * Sorts specialized at compile time for common element types and orders
+ *  They are instantiated from sort_template.h, so the comparison is inlined in
+ *  the merge loops instead of being called through a function pointer. The
+ *  generic functions taking an IntegerCompareFunction are still the ones to use
+ *  with custom orders, or to count the comparisons in the tests.
+ */
+#ifndef __SPECIALIZED_SORT_H__
+#define __SPECIALIZED_SORT_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+
+/*
+ * The array sorts are stable merge sorts. scratch must have room for count
+ * elements, if NULL a temporary buffer is reserved.
+ */
+
+/**
+ * \brief Sort an array of int32_t in ascending order
+ */
+void int32AscendingSort(int32_t *values, size_t count, int32_t *scratch);
+
+/**
+ * \brief Sort an array of int32_t in descending order
+ */
+void int32DescendingSort(int32_t *values, size_t count, int32_t *scratch);
+
+/**
+ * \brief Sort an array of int64_t in ascending order
+ */
+void int64AscendingSort(int64_t *values, size_t count, int64_t *scratch);
+
+/**
+ * \brief Sort an array of uint32_t in ascending order
+ */
+void uint32AscendingSort(uint32_t *values, size_t count, uint32_t *scratch);
+
+/**
+ * \brief Sort an array of float in ascending order, NaN values are placed last
+ */
+void floatAscendingSort(float *values, size_t count, float *scratch);
+
+/**
+ * \brief Sort an array of nodes of an integer list by the value they hold,
+ * in ascending order. The key is extracted with integerListNodeValue.
+ */
+void integerNodeAscendingSort(struct ListNode **nodes, size_t count, struct ListNode **scratch);
+
+/**
+ * \brief Stable in place merge sort of an integer list in ascending order,
+ * the same result as integerListMergeSortInPlace with lessThan.
+ */
+void int32AscendingListSort(struct List *list);
+
+/**
+ * \brief Stable in place merge sort of an integer list in descending order,
+ * the same result as integerListMergeSortInPlace with greaterThan.
+ */
+void int32DescendingListSort(struct List *list);
+
+/**
+ * \brief Sort an integer list, using the specialized sorts for ascending compare
+ * functions (see integerCompareIsAscending) and greaterThan, and integerListMergeSortInPlace for other compare functions.
+ * \param list    The list to be sorted
+ * \param compare Function that tells if a should be located before b
+ */
+void integerListSpecializedSort(struct List *list, IntegerCompareFunction compare);
+
+#endif //__SPECIALIZED_SORT_H__
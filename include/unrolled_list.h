@@ -0,0 +1,109 @@
+/**
+ * An unrolled linked list of integers, every node holds a small array of values
+ */
+#ifndef __UNROLLED_LIST_H__
+#define __UNROLLED_LIST_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+#include "merge_sort.h"
+
+/* Values stored in every node, a node takes 4 cache lines */
+#define UNROLLED_LIST_NODE_CAPACITY 56
+
+struct UnrolledListNode {
+    struct UnrolledListNode *next;  /* Next node of the list */
+    struct UnrolledListNode *prev;  /* Previous node in the list */
+    size_t count;                   /* Values used in this node */
+    int32_t values[UNROLLED_LIST_NODE_CAPACITY]; /* Values stored, in list order */
+};
+
+struct UnrolledList {
+    struct UnrolledListNode *head;  /* First node of the list */
+    struct UnrolledListNode *tail;  /* Last node of the list */
+    size_t count;                   /* Element count */
+    size_t nodeCount;               /* Amount of nodes */
+};
+
+/**
+ * \brief Creates an empty Unrolled List
+ * \return A pointer to the newly created list.
+ */
+struct UnrolledList *unrolledListCreate(void);
+
+/**
+ * \brief Creates an Unrolled List and Initializes it with a set of values
+ * \param count    Amount of elements to be added to the new list
+ * \param elements Elements to be added to the list
+ * \return         A pointer to a new list containing the given elements
+ */
+struct UnrolledList *unrolledListCreateWithElements(size_t count, int32_t elements[]);
+
+/**
+ * \brief Frees the memory related to an Unrolled List
+ * \param list The list to be freed
+ */
+void unrolledListDestroy(struct UnrolledList *list);
+
+/**
+ * \brief Adds an integer to the begining of the list
+ * \param list  The list to be modified
+ * \param value Value to be added to the list
+ * \return      RET_OK if it was successful or RET_FAIL on a failure.
+ */
+enum ListReturnType unrolledListAppendStart(struct UnrolledList *list, int32_t value);
+
+/**
+ * \brief Adds an integer to the end of the list
+ * \param list  The list to be modified
+ * \param value Value to be added to the list
+ * \return      RET_OK if it was successful or RET_FAIL on a failure.
+ */
+enum ListReturnType unrolledListAppendEnd(struct UnrolledList *list, int32_t value);
+
+/**
+ * \brief Insert an integer at a given position.
+ * A full node is split in 2 halves, so the insertion only moves the values of
+ * a single node once the position is found.
+ * \param list  The list to be modified
+ * \param index Position of the new value, from 0 to the element count
+ * \param value Value to be added to the list
+ * \return      RET_OK if it was succesfull or RET_FAIL otherwise.
+ */
+enum ListReturnType unrolledListInsert(struct UnrolledList *list, size_t index, int32_t value);
+
+/**
+ * \brief Get the first element from the list and remove it from the list
+ * \param list  The list to be modified
+ * \param value Output for the removed value
+ * \return      RET_OK if a value was removed or RET_FAIL if the list is empty.
+ */
+enum ListReturnType unrolledListPop(struct UnrolledList *list, int32_t *value);
+
+/**
+ * \brief Run the given callback function on all elements.
+ * The callback gets a pointer to every int32_t value, it should return true to
+ * continue with the next element or false to end the iteration.
+ * \param list     List containing the elements
+ * \param callback Callback function to be called for each element
+ * \param userData User data to be passed for every element
+ */
+void unrolledListForEach(struct UnrolledList *list, ListCallback callback, void *userData);
+
+/**
+ * \brief Print all elements in an Unrolled List
+ * \param list List to be printed
+ */
+void unrolledListPrint(struct UnrolledList *list);
+
+/**
+ * \brief Sort an Unrolled List.
+ * Every node is sorted in place with insertion sort, then the sorted nodes are
+ * merged bottom up into new packed nodes. Neighbour runs already in order are
+ * concatenated without moving their values. The sort is stable.
+ * \param list    The list to be sorted
+ * \param compare Function that tells if a should be located before b
+ */
+void unrolledListSort(struct UnrolledList *list, IntegerCompareFunction compare);
+
+#endif //__UNROLLED_LIST_H__
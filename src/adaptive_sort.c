@@ -0,0 +1,150 @@
+#include "adaptive_sort.h"
+#include "gather_sort.h"
+#include "integer_list.h"
+#include "parallel_sort.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdlib.h>
+
+/* Sampled values spanning less than this take less radix passes */
+#define ADAPTIVE_SORT_SMALL_RANGE (1u << 16)
+
+static struct AdaptiveSortThresholds adaptiveThresholds = ADAPTIVE_SORT_DEFAULT_THRESHOLDS;
+
+void adaptiveSortSetThresholds(const struct AdaptiveSortThresholds *thresholds){
+    if(thresholds != NULL) adaptiveThresholds = *thresholds;
+}
+
+void adaptiveSortGetThresholds(struct AdaptiveSortThresholds *thresholds){
+    if(thresholds != NULL) *thresholds = adaptiveThresholds;
+}
+
+const char *adaptiveSortStrategyName(enum AdaptiveSortStrategy strategy){
+    switch(strategy){
+        case ADAPTIVE_SORT_NONE:          return "none";
+        case ADAPTIVE_SORT_INSERTION:     return "insertion";
+        case ADAPTIVE_SORT_NATURAL_MERGE: return "natural_merge";
+        case ADAPTIVE_SORT_RADIX:         return "radix";
+        case ADAPTIVE_SORT_PARALLEL:      return "parallel";
+        case ADAPTIVE_SORT_MERGE:         return "merge";
+    }
+    return "unknown";
+}
+
+/**
+ * \brief Walk the list once taking one value and the direction of its next 2
+ * neighbour pairs every stride nodes. A run of the natural merge breaks where the
+ * direction changes, so ascending and descending runs both count as one run.
+ */
+static void adaptiveSample(const struct List *list, IntegerCompareFunction compare, size_t sampleSize,
+                           struct AdaptiveSortReport *report){
+    int32_t *samples = (int32_t *) xzalloc(sampleSize, sizeof(int32_t));
+    size_t stride = (list->count > sampleSize) ? list->count / sampleSize : 1;
+    size_t index = 0;
+    for(struct ListNode *node = list->head; (node != NULL) && (report->sampledValues < sampleSize);
+        node = node->next, index++){
+        if(index % stride != 0) continue;
+        int32_t value = integerListNodeValue(node);
+        if((report->sampledValues == 0) || (value < report->minimum)) report->minimum = value;
+        if((report->sampledValues == 0) || (value > report->maximum)) report->maximum = value;
+        samples[report->sampledValues++] = value;
+        if((node->next == NULL) || (node->next->next == NULL)) continue;
+
+        int32_t next = integerListNodeValue(node->next);
+        bool descending = SORT_COMPARE(compare, next, value);
+        bool nextDescending = SORT_COMPARE(compare, integerListNodeValue(node->next->next), next);
+        report->sampledPairs++;
+        if(descending) report->descents++;
+        if(descending != nextDescending) report->runBreaks++;
+    }
+
+    /* The samples are few, so the inversions between them are counted directly */
+    for(size_t i = 0; i < report->sampledValues; i++){
+        for(size_t j = i + 1; j < report->sampledValues; j++){
+            if(SORT_COMPARE(compare, samples[j], samples[i])) report->inversions++;
+        }
+    }
+    free(samples);
+
+    if(report->sampledPairs > 0){
+        report->estimatedRuns = (size_t) ((double) report->runBreaks * (list->count - 2) / report->sampledPairs) + 1;
+    }
+}
+
+enum ListReturnType integerListAdaptivePlan(const struct List *list, IntegerCompareFunction compare,
+                                            struct AdaptiveSortReport *report){
+    if((list == NULL) || (report == NULL)) return RET_FAIL;
+    const struct AdaptiveSortThresholds *thresholds = &adaptiveThresholds;
+    *report = (struct AdaptiveSortReport) { .count = list->count };
+
+    /* The recorded sorted prefix is only a hint, a list marked sorted is checked with one walk */
+    if((list->count <= 1) || (integerListSortedPrefix(list, compare) >= list->count)){
+        report->strategy = ADAPTIVE_SORT_NONE;
+        report->estimatedRuns = (list->count > 0) ? 1 : 0;
+        return RET_OK;
+    }
+    if((list->count <= thresholds->insertionMaxSize) || (list->count < 3)){
+        report->strategy = ADAPTIVE_SORT_INSERTION;
+        return RET_OK;
+    }
+
+    /* At least 2 values and 1 pair of neighbours are sampled from a list of 3 or more nodes */
+    adaptiveSample(list, compare, (thresholds->sampleSize < 2) ? 2 : thresholds->sampleSize, report);
+    size_t breakPerMille = report->runBreaks * 1000 / report->sampledPairs;
+    size_t samplePairs = report->sampledValues * (report->sampledValues - 1) / 2;
+    size_t inversionPerMille = report->inversions * 1000 / samplePairs;
+    bool nearlyOrdered = (inversionPerMille <= thresholds->runMaxInversionPerMille) ||
+                         (inversionPerMille + thresholds->runMaxInversionPerMille >= 1000);
+    uint32_t range = (uint32_t) ((int64_t) report->maximum - report->minimum);
+
+    if((breakPerMille <= thresholds->runMaxBreakPerMille) ||
+       (nearlyOrdered && (breakPerMille <= 4 * thresholds->runMaxBreakPerMille))){
+        report->strategy = ADAPTIVE_SORT_NATURAL_MERGE;
+    } else if(integerCompareIsAscending(compare) &&
+              ((list->count >= thresholds->radixMinSize) ||
+               ((range < ADAPTIVE_SORT_SMALL_RANGE) && (list->count >= thresholds->radixSmallRangeMinSize)))){
+        report->strategy = ADAPTIVE_SORT_RADIX;
+    } else if((list->count >= thresholds->parallelMinSize) && (parallelSortDefaultThreads() > 1)){
+        report->strategy = ADAPTIVE_SORT_PARALLEL;
+    } else {
+        report->strategy = ADAPTIVE_SORT_MERGE;
+    }
+    return RET_OK;
+}
+
+enum ListReturnType integerListAdaptiveSortWithReport(struct List *list, IntegerCompareFunction compare,
+                                                      struct AdaptiveSortReport *report){
+    struct AdaptiveSortReport localReport;
+    if(report == NULL) report = &localReport;
+    if(integerListAdaptivePlan(list, compare, report) != RET_OK) return RET_FAIL;
+
+    switch(report->strategy){
+        case ADAPTIVE_SORT_NONE:
+            integerListMarkSorted(list, compare);
+            break;
+        case ADAPTIVE_SORT_INSERTION:
+            integerListInsertionSort(list, compare);
+            break;
+        case ADAPTIVE_SORT_NATURAL_MERGE:
+            integerListNaturalMergeSort(list, compare);
+            break;
+        case ADAPTIVE_SORT_RADIX:
+            if(list->count >= adaptiveThresholds.parallelMinSize){
+                integerListParallelRadixSort(list, 0);
+            } else {
+                integerListGatherSort(list, compare, GATHER_SORT_VALUES, NULL);
+            }
+            break;
+        case ADAPTIVE_SORT_PARALLEL:
+            integerListParallelSort(list, compare);
+            break;
+        case ADAPTIVE_SORT_MERGE:
+            integerListMergeSortInPlace(list, compare);
+            break;
+    }
+    return RET_OK;
+}
+
+void integerListAdaptiveSort(struct List *list, IntegerCompareFunction compare){
+    integerListAdaptiveSortWithReport(list, compare, NULL);
+}
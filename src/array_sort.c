@@ -0,0 +1,139 @@
+#include "array_sort.h"
+#include "simd_sort.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Arrays smaller than this are sorted with the sorting network kernel */
+#define RADIX_SORT_MIN_SIZE SIMD_SORT_BLOCK_SIZE
+
+struct ArraySortScratch *arraySortScratchCreate(size_t capacity){
+    struct ArraySortScratch *scratch = (struct ArraySortScratch *) xzalloc(1, sizeof(struct ArraySortScratch));
+    if(capacity > 0){
+        scratch->buffer = (int32_t *) xzalloc(capacity, sizeof(int32_t));
+        scratch->capacity = capacity;
+    }
+    return scratch;
+}
+
+int32_t *arraySortScratchReserve(struct ArraySortScratch *scratch, size_t count){
+    if(count > scratch->capacity){
+        free(scratch->buffer);
+        scratch->buffer = (int32_t *) xzalloc(count, sizeof(int32_t));
+        scratch->capacity = count;
+    }
+    return scratch->buffer;
+}
+
+void arraySortScratchDestroy(struct ArraySortScratch *scratch){
+    if(scratch == NULL) return;
+    free(scratch->buffer);
+    free(scratch);
+}
+
+/* The sign bit is flipped, so the negative values are placed first */
+#define RADIX_NAME int32
+#define RADIX_TYPE int32_t
+#define RADIX_KEY(x) (((uint32_t) (x)) ^ 0x80000000u)
+#include "radix_template.h"
+
+void integerArrayRadixSort(int32_t *values, size_t count, struct ArraySortScratch *scratch){
+    if(count < RADIX_SORT_MIN_SIZE){
+        int32SortBlock(values, count);
+        return;
+    }
+
+    struct ArraySortScratch *ownScratch = NULL;
+    if(scratch == NULL){
+        ownScratch = arraySortScratchCreate(count);
+        scratch = ownScratch;
+    }
+    int32_t *buffer = arraySortScratchReserve(scratch, count);
+    int32_t *src = int32RadixSort(values, buffer, count);
+
+    /* An odd amount of passes leaves the result in the scratch buffer */
+    if(src != values){
+        memcpy(values, src, count * sizeof(int32_t));
+    }
+
+    arraySortScratchDestroy(ownScratch);
+}
+
+/* Blocks of this size are sorted with insertion sort before the merge passes */
+#define MERGE_SORT_BLOCK_SIZE 16
+
+/**
+ * \brief Stable insertion sort using a compare function
+ */
+static void insertionSortCompare(int32_t *values, size_t count, IntegerCompareFunction compare){
+    for(size_t i = 1; i < count; i++){
+        int32_t value = values[i];
+        size_t j = i;
+        while((j > 0) && SORT_COMPARE(compare, value, values[j - 1])){
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+void integerArrayMerge(const int32_t *left, size_t leftCount, const int32_t *right, size_t rightCount,
+                       int32_t *dst, IntegerCompareFunction compare){
+    SORT_STATS_ADD(merges, 1);
+    SORT_STATS_ADD(nodeMoves, leftCount + rightCount);
+    size_t i = 0;
+    size_t j = 0;
+    while((i < leftCount) && (j < rightCount)){
+        if(SORT_COMPARE(compare, right[j], left[i])){
+            *dst++ = right[j++];
+        } else {
+            *dst++ = left[i++];
+        }
+    }
+    memcpy(dst, left + i, (leftCount - i) * sizeof(int32_t));
+    dst += leftCount - i;
+    memcpy(dst, right + j, (rightCount - j) * sizeof(int32_t));
+}
+
+void integerArrayMergeSort(int32_t *values, size_t count, IntegerCompareFunction compare, struct ArraySortScratch *scratch){
+    /* The default ascending order sorts larger blocks with the sorting network kernel */
+    bool useKernel = integerCompareIsAscending(compare);
+    size_t blockSize = useKernel ? SIMD_SORT_BLOCK_SIZE : MERGE_SORT_BLOCK_SIZE;
+    for(size_t i = 0; i < count; i += blockSize){
+        size_t blockCount = (count - i < blockSize) ? count - i : blockSize;
+        if(useKernel){
+            int32SortBlock(values + i, blockCount);
+        } else {
+            insertionSortCompare(values + i, blockCount, compare);
+        }
+    }
+    if(count <= blockSize) return;
+
+    struct ArraySortScratch *ownScratch = NULL;
+    if(scratch == NULL){
+        ownScratch = arraySortScratchCreate(count);
+        scratch = ownScratch;
+    }
+    int32_t *src = values;
+    int32_t *dst = arraySortScratchReserve(scratch, count);
+
+    for(size_t width = blockSize; width < count; width *= 2){
+        SORT_STATS_ADD(mergePasses, 1);
+        for(size_t i = 0; i < count; i += 2 * width){
+            size_t leftCount = (count - i < width) ? count - i : width;
+            size_t rightCount = (count - i - leftCount < width) ? count - i - leftCount : width;
+            integerArrayMerge(src + i, leftCount, src + i + leftCount, rightCount, dst + i, compare);
+        }
+        int32_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* An odd amount of passes leaves the result in the scratch buffer */
+    if(src != values){
+        memcpy(values, src, count * sizeof(int32_t));
+    }
+
+    arraySortScratchDestroy(ownScratch);
+}
@@ -0,0 +1,227 @@
+#include "compact_list.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Enough bins for any list that fits in 32 bit indices, bin i holds a sorted run of 2^i nodes */
+#define COMPACT_SORT_MAX_BINS 33
+
+/* A run of nodes being merged, linked through next and ended by COMPACT_LIST_NIL */
+struct CompactRun {
+    uint32_t head;
+    uint32_t tail;
+};
+
+struct CompactList *compactListCreate(size_t capacity){
+    struct CompactList *list = (struct CompactList *) xzalloc(1, sizeof(struct CompactList));
+    list->head = COMPACT_LIST_NIL;
+    list->tail = COMPACT_LIST_NIL;
+    list->freeList = COMPACT_LIST_NIL;
+    if(capacity > 0) compactListReserve(list, capacity);
+    return list;
+}
+
+struct CompactList *compactListCreateWithElements(size_t count, const int32_t elements[]){
+    struct CompactList *list = compactListCreate(count);
+    for(size_t i = 0; i < count; i++){
+        compactListAppendEnd(list, elements[i]);
+    }
+    return list;
+}
+
+void compactListDestroy(struct CompactList *list){
+    if(list == NULL) return;
+    free(list->nodes);
+    free(list);
+}
+
+enum ListReturnType compactListReserve(struct CompactList *list, size_t capacity){
+    if(list == NULL) return RET_FAIL;
+    if(capacity <= list->capacity) return RET_OK;
+    if(capacity > COMPACT_LIST_MAX_NODES) return RET_FAIL;
+    struct CompactListNode *nodes = (struct CompactListNode *) xzalloc(capacity, sizeof(struct CompactListNode));
+    if(list->used > 0) memcpy(nodes, list->nodes, list->used * sizeof(struct CompactListNode));
+    free(list->nodes);
+    list->nodes = nodes;
+    list->capacity = capacity;
+    return RET_OK;
+}
+
+/**
+ * \brief Take a node from the free list or from the storage, growing it when full
+ * \return The index of the node or COMPACT_LIST_NIL if the list is full.
+ */
+static uint32_t compactListNodeAlloc(struct CompactList *list, int32_t value){
+    uint32_t index;
+    if(list->freeList != COMPACT_LIST_NIL){
+        index = list->freeList;
+        list->freeList = list->nodes[index].next;
+    } else {
+        if(list->used == list->capacity){
+            size_t capacity = (list->capacity > 0) ? 2 * list->capacity : COMPACT_LIST_DEFAULT_CAPACITY;
+            if(capacity > COMPACT_LIST_MAX_NODES) capacity = COMPACT_LIST_MAX_NODES;
+            if(compactListReserve(list, capacity) != RET_OK || (list->used == list->capacity)) return COMPACT_LIST_NIL;
+        }
+        index = (uint32_t) list->used++;
+    }
+    list->nodes[index].value = value;
+    return index;
+}
+
+uint32_t compactListInsertAfter(struct CompactList *list, uint32_t previous, int32_t value){
+    if(list == NULL) return COMPACT_LIST_NIL;
+    uint32_t index = compactListNodeAlloc(list, value);
+    if(index == COMPACT_LIST_NIL) return COMPACT_LIST_NIL;
+
+    struct CompactListNode *nodes = list->nodes;
+    uint32_t next = (previous != COMPACT_LIST_NIL) ? nodes[previous].next : list->head;
+    nodes[index].prev = previous;
+    nodes[index].next = next;
+    if(next != COMPACT_LIST_NIL) {
+        nodes[next].prev = index;
+    } else {
+        list->tail = index;
+    }
+    if(previous != COMPACT_LIST_NIL) {
+        nodes[previous].next = index;
+    } else {
+        list->head = index;
+    }
+    list->count++;
+    return index;
+}
+
+enum ListReturnType compactListAppendStart(struct CompactList *list, int32_t value){
+    return (compactListInsertAfter(list, COMPACT_LIST_NIL, value) != COMPACT_LIST_NIL) ? RET_OK : RET_FAIL;
+}
+
+enum ListReturnType compactListAppendEnd(struct CompactList *list, int32_t value){
+    if(list == NULL) return RET_FAIL;
+    return (compactListInsertAfter(list, list->tail, value) != COMPACT_LIST_NIL) ? RET_OK : RET_FAIL;
+}
+
+enum ListReturnType compactListRemove(struct CompactList *list, uint32_t node){
+    if((list == NULL) || (list->count == 0) || (node == COMPACT_LIST_NIL)) return RET_FAIL;
+    struct CompactListNode *nodes = list->nodes;
+    if(nodes[node].prev != COMPACT_LIST_NIL) {
+        nodes[nodes[node].prev].next = nodes[node].next;
+    } else {
+        list->head = nodes[node].next;
+    }
+    if(nodes[node].next != COMPACT_LIST_NIL) {
+        nodes[nodes[node].next].prev = nodes[node].prev;
+    } else {
+        list->tail = nodes[node].prev;
+    }
+    nodes[node].prev = COMPACT_LIST_NIL;
+    nodes[node].next = list->freeList;
+    list->freeList = node;
+    list->count--;
+    return RET_OK;
+}
+
+enum ListReturnType compactListPop(struct CompactList *list, int32_t *value){
+    if((list == NULL) || (list->count == 0)) return RET_FAIL;
+    if(value != NULL) *value = list->nodes[list->head].value;
+    return compactListRemove(list, list->head);
+}
+
+void compactListForEach(struct CompactList *list, ListCallback callback, void *userData){
+    if(list == NULL) return;
+    for(uint32_t node = list->head; node != COMPACT_LIST_NIL; node = list->nodes[node].next){
+        if(!callback(&list->nodes[node].value, userData)) return;
+    }
+}
+
+void compactListPrint(struct CompactList *list){
+    printf("[");
+    compactListForEach(list, integerListPrintElement, " %d ");
+    printf("]\n");
+}
+
+/**
+ * \brief Stable merge of 2 runs, on ties the nodes of a go first. Only the next links are set.
+ */
+static struct CompactRun compactMergeRuns(struct CompactListNode *nodes, struct CompactRun a, struct CompactRun b,
+                                          IntegerCompareFunction compare){
+    struct CompactRun result;
+    SORT_STATS_ADD(merges, 1);
+    /* Runs already in order are concatenated without walking them */
+    if(!SORT_COMPARE(compare, nodes[b.head].value, nodes[a.tail].value)){
+        nodes[a.tail].next = b.head;
+        return (struct CompactRun) { .head = a.head, .tail = b.tail };
+    }
+    if(SORT_COMPARE(compare, nodes[b.tail].value, nodes[a.head].value)){
+        nodes[b.tail].next = a.head;
+        return (struct CompactRun) { .head = b.head, .tail = a.tail };
+    }
+
+    uint32_t *link = &result.head;
+    uint32_t i = a.head;
+    uint32_t j = b.head;
+    for(;;){
+        if(SORT_COMPARE(compare, nodes[j].value, nodes[i].value)){
+            *link = j;
+            link = &nodes[j].next;
+            j = *link;
+            if(j == COMPACT_LIST_NIL){
+                *link = i;
+                result.tail = a.tail;
+                return result;
+            }
+        } else {
+            *link = i;
+            link = &nodes[i].next;
+            i = *link;
+            if(i == COMPACT_LIST_NIL){
+                *link = j;
+                result.tail = b.tail;
+                return result;
+            }
+        }
+    }
+}
+
+void compactListSort(struct CompactList *list, IntegerCompareFunction compare){
+    if((list == NULL) || (list->count <= 1)) return;
+    struct CompactListNode *nodes = list->nodes;
+
+    /* Feed the nodes one by one, carrying merges like a binary counter O(n log n) */
+    struct CompactRun bins[COMPACT_SORT_MAX_BINS];
+    size_t usedBins = 0;
+    uint32_t node = list->head;
+    while(node != COMPACT_LIST_NIL){
+        uint32_t next = nodes[node].next;
+        nodes[node].next = COMPACT_LIST_NIL;
+        struct CompactRun carry = { .head = node, .tail = node };
+        size_t i = 0;
+        while((i < usedBins) && (bins[i].head != COMPACT_LIST_NIL)){
+            /* bins[i] holds older nodes, keep it first for stability */
+            carry = compactMergeRuns(nodes, bins[i], carry, compare);
+            bins[i].head = COMPACT_LIST_NIL;
+            i++;
+        }
+        if(i == usedBins) usedBins++;
+        bins[i] = carry;
+        node = next;
+    }
+
+    struct CompactRun result = { .head = COMPACT_LIST_NIL, .tail = COMPACT_LIST_NIL };
+    for(size_t i = 0; i < usedBins; i++){
+        if(bins[i].head == COMPACT_LIST_NIL) continue;
+        result = (result.head == COMPACT_LIST_NIL) ? bins[i] : compactMergeRuns(nodes, bins[i], result, compare);
+    }
+
+    /* Rebuild the prev links in one pass */
+    uint32_t prev = COMPACT_LIST_NIL;
+    for(node = result.head; node != COMPACT_LIST_NIL; node = nodes[node].next){
+        nodes[node].prev = prev;
+        prev = node;
+    }
+    list->head = result.head;
+    list->tail = result.tail;
+    SORT_STATS_ADD(nodeMoves, list->count);
+}
@@ -0,0 +1,413 @@
+#include "external_sort.h"
+#include "array_sort.h"
+#include "utils.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Smallest buffer used for every run while merging, in bytes */
+#define EXTERNAL_SORT_MIN_BUFFER (64 * 1024)
+/* Upper limit for the amount of runs merged at once */
+#define EXTERNAL_SORT_MAX_FAN_IN 512
+
+/* A sorted run stored in a temporary file */
+struct ExternalRun {
+    off_t offset;  /* Position of the first value in the file, in bytes */
+    size_t count;  /* Amount of values in the run */
+};
+
+/* Buffered reader of a run */
+struct RunReader {
+    int fd;
+    off_t offset;      /* Position of the next value to be read from the file */
+    size_t remaining;  /* Values of the run not read from the file yet */
+    int32_t *buffer;
+    size_t capacity;
+    size_t position;   /* Next value to be consumed from the buffer */
+    size_t length;     /* Values available in the buffer */
+};
+
+/* Writer that writes a full buffer in a second thread while the other one is being filled */
+struct AsyncWriter {
+    int fd;
+    int32_t *buffers[2];
+    size_t capacity;       /* Values that fit in every buffer */
+    int32_t *current;      /* Buffer being filled */
+    size_t used;           /* Values in the current buffer */
+    int32_t *pending;      /* Buffer handed to the writer thread, NULL if there is none */
+    size_t pendingCount;
+    bool threaded;         /* The writer thread is running */
+    bool done;             /* No more buffers will be handed to the thread */
+    bool failed;           /* A write failed */
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+};
+
+void externalSortDefaultOptions(struct ExternalSortOptions *options){
+    options->memoryBudget = EXTERNAL_SORT_DEFAULT_MEMORY_BUDGET;
+    options->tempDir = NULL;
+    options->maxFanIn = 0;
+}
+
+/************************  File helpers  **************************/
+
+static bool readAll(int fd, void *buffer, size_t bytes, off_t offset){
+    char *ptr = (char *) buffer;
+    while(bytes > 0){
+        ssize_t n = pread(fd, ptr, bytes, offset);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) return false;
+        ptr += n;
+        bytes -= (size_t) n;
+        offset += n;
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void *buffer, size_t bytes){
+    const char *ptr = (const char *) buffer;
+    while(bytes > 0){
+        ssize_t n = write(fd, ptr, bytes);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) return false;
+        ptr += n;
+        bytes -= (size_t) n;
+    }
+    return true;
+}
+
+/**
+ * \brief Create an anonymous temporary file, it is removed from the directory
+ * right away so it disappears when it is closed.
+ */
+static int createTempFile(const char *tempDir){
+    if(tempDir == NULL) tempDir = getenv("TMPDIR");
+    if(tempDir == NULL) tempDir = "/tmp";
+    size_t length = strlen(tempDir) + sizeof("/mergesort-run-XXXXXX");
+    char *path = (char *) xzalloc(length, sizeof(char));
+    snprintf(path, length, "%s/mergesort-run-XXXXXX", tempDir);
+    int fd = mkstemp(path);
+    if(fd >= 0){
+        unlink(path);
+    } else {
+        fprintf(stderr, "Error: Failed to create a temporary file in %s: %s\n", tempDir, strerror(errno));
+    }
+    free(path);
+    return fd;
+}
+
+/************************  Async writer  **************************/
+
+static void *asyncWriterMain(void *arg){
+    struct AsyncWriter *writer = (struct AsyncWriter *) arg;
+    pthread_mutex_lock(&writer->lock);
+    for(;;){
+        while((writer->pending == NULL) && !writer->done){
+            pthread_cond_wait(&writer->changed, &writer->lock);
+        }
+        if(writer->pending == NULL) break;
+        int32_t *buffer = writer->pending;
+        size_t count = writer->pendingCount;
+        pthread_mutex_unlock(&writer->lock);
+        bool ok = writeAll(writer->fd, buffer, count * sizeof(int32_t));
+        pthread_mutex_lock(&writer->lock);
+        if(!ok) writer->failed = true;
+        writer->pending = NULL;
+        pthread_cond_broadcast(&writer->changed);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+static void asyncWriterInit(struct AsyncWriter *writer, int fd, size_t capacity){
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = fd;
+    writer->capacity = capacity;
+    writer->buffers[0] = (int32_t *) xzalloc(capacity, sizeof(int32_t));
+    writer->buffers[1] = (int32_t *) xzalloc(capacity, sizeof(int32_t));
+    writer->current = writer->buffers[0];
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->changed, NULL);
+    /* Without a thread the buffers are written synchronously */
+    writer->threaded = (pthread_create(&writer->thread, NULL, asyncWriterMain, writer) == 0);
+}
+
+/**
+ * \brief Hand the current buffer to the writer thread and continue with the other one
+ */
+static void asyncWriterFlush(struct AsyncWriter *writer){
+    if(writer->used == 0) return;
+    if(!writer->threaded){
+        if(!writeAll(writer->fd, writer->current, writer->used * sizeof(int32_t))) writer->failed = true;
+        writer->used = 0;
+        return;
+    }
+    pthread_mutex_lock(&writer->lock);
+    while(writer->pending != NULL){
+        pthread_cond_wait(&writer->changed, &writer->lock);
+    }
+    writer->pending = writer->current;
+    writer->pendingCount = writer->used;
+    pthread_cond_broadcast(&writer->changed);
+    pthread_mutex_unlock(&writer->lock);
+    writer->current = (writer->current == writer->buffers[0]) ? writer->buffers[1] : writer->buffers[0];
+    writer->used = 0;
+}
+
+static inline void asyncWriterPut(struct AsyncWriter *writer, int32_t value){
+    writer->current[writer->used++] = value;
+    if(writer->used == writer->capacity) asyncWriterFlush(writer);
+}
+
+/**
+ * \brief Write what is left, stop the writer thread and free the buffers
+ * \return true if all the values were written
+ */
+static bool asyncWriterClose(struct AsyncWriter *writer){
+    asyncWriterFlush(writer);
+    if(writer->threaded){
+        pthread_mutex_lock(&writer->lock);
+        writer->done = true;
+        pthread_cond_broadcast(&writer->changed);
+        pthread_mutex_unlock(&writer->lock);
+        pthread_join(writer->thread, NULL);
+    }
+    pthread_cond_destroy(&writer->changed);
+    pthread_mutex_destroy(&writer->lock);
+    free(writer->buffers[0]);
+    free(writer->buffers[1]);
+    return !writer->failed;
+}
+
+/*************************  Run readers  **************************/
+
+static bool runReaderRefill(struct RunReader *reader){
+    size_t count = (reader->remaining < reader->capacity) ? reader->remaining : reader->capacity;
+    if(count == 0) return false;
+    if(!readAll(reader->fd, reader->buffer, count * sizeof(int32_t), reader->offset)) return false;
+    reader->offset += (off_t) (count * sizeof(int32_t));
+    reader->remaining -= count;
+    reader->position = 0;
+    reader->length = count;
+    /* Let the kernel read the next block while this one is being merged */
+    size_t next = (reader->remaining < reader->capacity) ? reader->remaining : reader->capacity;
+    if(next > 0){
+        posix_fadvise(reader->fd, reader->offset, (off_t) (next * sizeof(int32_t)), POSIX_FADV_WILLNEED);
+    }
+    return true;
+}
+
+/****************************  Merge  *****************************/
+
+/**
+ * \brief Restore the heap order from position i down, the heap holds the
+ * indexes of the readers ordered by their current value.
+ */
+static void heapSiftDown(size_t *heap, size_t size, size_t i, struct RunReader *readers){
+    for(;;){
+        size_t smallest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        struct RunReader *s = &readers[heap[smallest]];
+        if(left < size){
+            struct RunReader *l = &readers[heap[left]];
+            if(l->buffer[l->position] < s->buffer[s->position]){
+                smallest = left;
+                s = l;
+            }
+        }
+        if(right < size){
+            struct RunReader *r = &readers[heap[right]];
+            if(r->buffer[r->position] < s->buffer[s->position]){
+                smallest = right;
+            }
+        }
+        if(smallest == i) return;
+        size_t tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+/**
+ * \brief Merge a group of runs stored in the input file into the writer
+ */
+static bool mergeRuns(int fd, const struct ExternalRun *runs, size_t runCount, size_t bufferCount, struct AsyncWriter *writer){
+    struct RunReader *readers = (struct RunReader *) xzalloc(runCount, sizeof(struct RunReader));
+    size_t *heap = (size_t *) xzalloc(runCount, sizeof(size_t));
+    size_t heapSize = 0;
+    bool ok = true;
+    for(size_t i = 0; i < runCount; i++){
+        readers[i].fd = fd;
+        readers[i].offset = runs[i].offset;
+        readers[i].remaining = runs[i].count;
+        readers[i].capacity = bufferCount;
+        readers[i].buffer = (int32_t *) xzalloc(bufferCount, sizeof(int32_t));
+        if(runReaderRefill(&readers[i])){
+            heap[heapSize++] = i;
+        } else if(runs[i].count > 0){
+            ok = false;
+        }
+    }
+    for(size_t i = heapSize; i-- > 0;){
+        heapSiftDown(heap, heapSize, i, readers);
+    }
+
+    while(ok && (heapSize > 0)){
+        struct RunReader *reader = &readers[heap[0]];
+        asyncWriterPut(writer, reader->buffer[reader->position++]);
+        if(reader->position == reader->length){
+            if(!runReaderRefill(reader)){
+                ok = (reader->remaining == 0);
+                heap[0] = heap[--heapSize];
+            }
+        }
+        if(heapSize > 0) heapSiftDown(heap, heapSize, 0, readers);
+    }
+
+    for(size_t i = 0; i < runCount; i++){
+        free(readers[i].buffer);
+    }
+    free(heap);
+    free(readers);
+    return ok;
+}
+
+/****************************  Sort  ******************************/
+
+/**
+ * \brief Read the input in chunks, sort them and write them as runs to the run file
+ * \return The amount of runs written or 0 on a failure, runs must have room for all of them.
+ */
+static size_t createRuns(int inputFd, size_t count, size_t chunkCount, int runFd, struct ExternalRun *runs){
+    int32_t *chunk = (int32_t *) xzalloc(chunkCount, sizeof(int32_t));
+    struct ArraySortScratch *scratch = arraySortScratchCreate(chunkCount);
+    size_t runCount = 0;
+    off_t inputOffset = 0;
+    off_t runOffset = 0;
+    while(count > 0){
+        size_t n = (count < chunkCount) ? count : chunkCount;
+        if(!readAll(inputFd, chunk, n * sizeof(int32_t), inputOffset)) {
+            runCount = 0;
+            break;
+        }
+        inputOffset += (off_t) (n * sizeof(int32_t));
+        integerArrayRadixSort(chunk, n, scratch);
+        if(!writeAll(runFd, chunk, n * sizeof(int32_t))) {
+            runCount = 0;
+            break;
+        }
+        runs[runCount].offset = runOffset;
+        runs[runCount].count = n;
+        runCount++;
+        runOffset += (off_t) (n * sizeof(int32_t));
+        count -= n;
+    }
+    arraySortScratchDestroy(scratch);
+    free(chunk);
+    return runCount;
+}
+
+enum ListReturnType externalSortFile(const char *inputPath, const char *outputPath, const struct ExternalSortOptions *options){
+    struct ExternalSortOptions defaults;
+    if(options == NULL){
+        externalSortDefaultOptions(&defaults);
+        options = &defaults;
+    }
+
+    int inputFd = open(inputPath, O_RDONLY);
+    if(inputFd < 0){
+        fprintf(stderr, "Error: Failed to open %s: %s\n", inputPath, strerror(errno));
+        return RET_FAIL;
+    }
+    struct stat st;
+    if((fstat(inputFd, &st) != 0) || (st.st_size % sizeof(int32_t) != 0)){
+        fprintf(stderr, "Error: %s is not a file of int32_t values\n", inputPath);
+        close(inputFd);
+        return RET_FAIL;
+    }
+    size_t count = (size_t) st.st_size / sizeof(int32_t);
+    posix_fadvise(inputFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    /* A chunk and the radix sort scratch buffer share the budget */
+    size_t chunkCount = options->memoryBudget / (2 * sizeof(int32_t));
+    if(chunkCount < EXTERNAL_SORT_MIN_BUFFER / sizeof(int32_t)) chunkCount = EXTERNAL_SORT_MIN_BUFFER / sizeof(int32_t);
+
+    /* Every input run and the 2 output buffers share the budget while merging */
+    size_t fanIn = options->maxFanIn;
+    if(fanIn == 0){
+        fanIn = options->memoryBudget / EXTERNAL_SORT_MIN_BUFFER;
+        fanIn = (fanIn > 2) ? fanIn - 2 : 2;
+        if(fanIn > EXTERNAL_SORT_MAX_FAN_IN) fanIn = EXTERNAL_SORT_MAX_FAN_IN;
+    }
+    if(fanIn < 2) fanIn = 2;
+    size_t bufferCount = options->memoryBudget / ((fanIn + 2) * sizeof(int32_t));
+    if(bufferCount < 1024) bufferCount = 1024;
+
+    size_t runCapacity = (count + chunkCount - 1) / chunkCount;
+    struct ExternalRun *runs = (struct ExternalRun *) xzalloc(runCapacity + 1, sizeof(struct ExternalRun));
+    int runFds[2] = { createTempFile(options->tempDir), -1 };
+    bool ok = (runFds[0] >= 0);
+    size_t runCount = 0;
+    if(ok && (count > 0)){
+        runCount = createRuns(inputFd, count, chunkCount, runFds[0], runs);
+        ok = (runCount > 0);
+    }
+    close(inputFd);
+
+    /* Merge groups of runs into a second run file until they fit in a single merge */
+    int current = 0;
+    while(ok && (runCount > fanIn)){
+        if(runFds[1 - current] < 0) runFds[1 - current] = createTempFile(options->tempDir);
+        int dstFd = runFds[1 - current];
+        ok = (dstFd >= 0) && (ftruncate(dstFd, 0) == 0) && (lseek(dstFd, 0, SEEK_SET) == 0);
+        if(!ok) break;
+        struct AsyncWriter writer;
+        asyncWriterInit(&writer, dstFd, bufferCount);
+        size_t merged = 0;
+        off_t offset = 0;
+        for(size_t first = 0; ok && (first < runCount); first += fanIn){
+            size_t group = (runCount - first < fanIn) ? runCount - first : fanIn;
+            size_t groupCount = 0;
+            for(size_t i = 0; i < group; i++) groupCount += runs[first + i].count;
+            ok = mergeRuns(runFds[current], runs + first, group, bufferCount, &writer);
+            runs[merged].offset = offset;
+            runs[merged].count = groupCount;
+            offset += (off_t) (groupCount * sizeof(int32_t));
+            merged++;
+        }
+        ok = asyncWriterClose(&writer) && ok;
+        runCount = merged;
+        current = 1 - current;
+    }
+
+    /* Last merge, straight to the output file */
+    if(ok){
+        int outputFd = open(outputPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(outputFd < 0){
+            fprintf(stderr, "Error: Failed to open %s: %s\n", outputPath, strerror(errno));
+            ok = false;
+        } else {
+            struct AsyncWriter writer;
+            asyncWriterInit(&writer, outputFd, bufferCount);
+            ok = mergeRuns(runFds[current], runs, runCount, bufferCount, &writer);
+            ok = asyncWriterClose(&writer) && ok;
+            ok = (close(outputFd) == 0) && ok;
+        }
+    }
+
+    if(runFds[0] >= 0) close(runFds[0]);
+    if(runFds[1] >= 0) close(runFds[1]);
+    free(runs);
+    if(!ok) fprintf(stderr, "Error: Failed to sort %s\n", inputPath);
+    return ok ? RET_OK : RET_FAIL;
+}
@@ -0,0 +1,47 @@
+#include "file_view.h"
+#include "integer_list.h"
+#include "utils.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct IntegerFileView *integerFileViewOpen(const char *path){
+    if(path == NULL) return NULL;
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return NULL;
+    struct stat info;
+    if(fstat(fd, &info) != 0){
+        close(fd);
+        return NULL;
+    }
+
+    struct IntegerFileView *view = (struct IntegerFileView *) xzalloc(1, sizeof(struct IntegerFileView));
+    view->size = (size_t) info.st_size;
+    view->count = view->size / sizeof(int32_t);
+    if(view->size > 0){
+        void *map = mmap(NULL, view->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map == MAP_FAILED){
+            close(fd);
+            free(view);
+            return NULL;
+        }
+        /* The list is built walking the file once */
+        madvise(map, view->size, MADV_SEQUENTIAL);
+        view->map = map;
+        view->values = (const int32_t *) map;
+    }
+    /* The mapping stays valid after closing the file */
+    close(fd);
+
+    view->list = integerListCreateView(view->count, view->values);
+    return view;
+}
+
+void integerFileViewClose(struct IntegerFileView *view){
+    if(view == NULL) return;
+    listDestroy(view->list);
+    if(view->map != NULL) munmap(view->map, view->size);
+    free(view);
+}
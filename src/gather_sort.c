@@ -0,0 +1,166 @@
+#include "gather_sort.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Blocks of this size are sorted with insertion sort before merging the pairs */
+#define PAIR_MERGE_BLOCK_SIZE 16
+
+/* A value gathered from the list and the node holding it */
+struct GatherPair {
+    int32_t key;
+    struct ListNode *node;
+};
+
+static size_t gatherThreshold = GATHER_SORT_DEFAULT_THRESHOLD;
+
+void integerListGatherSetThreshold(size_t threshold){
+    gatherThreshold = threshold;
+}
+
+/* Radix sort of the pairs by key, the sign bit is flipped so the negative values go first */
+#define RADIX_NAME pair
+#define RADIX_TYPE struct GatherPair
+#define RADIX_KEY(x) (((uint32_t) (x).key) ^ 0x80000000u)
+#include "radix_template.h"
+
+/**
+ * \brief Stable bottom up merge sort of the pairs using a compare function.
+ * \return The array holding the result, pairs or buffer.
+ */
+static struct GatherPair *pairMergeSort(struct GatherPair *pairs, struct GatherPair *buffer, size_t count,
+                                        IntegerCompareFunction compare){
+    for(size_t start = 0; start < count; start += PAIR_MERGE_BLOCK_SIZE){
+        size_t end = (count - start < PAIR_MERGE_BLOCK_SIZE) ? count : start + PAIR_MERGE_BLOCK_SIZE;
+        for(size_t i = start + 1; i < end; i++){
+            struct GatherPair pair = pairs[i];
+            size_t j = i;
+            while((j > start) && SORT_COMPARE(compare, pair.key, pairs[j - 1].key)){
+                pairs[j] = pairs[j - 1];
+                j--;
+            }
+            pairs[j] = pair;
+        }
+    }
+
+    struct GatherPair *src = pairs;
+    struct GatherPair *dst = buffer;
+    for(size_t width = PAIR_MERGE_BLOCK_SIZE; width < count; width *= 2){
+        SORT_STATS_ADD(mergePasses, 1);
+        for(size_t start = 0; start < count; start += 2 * width){
+            size_t middle = (count - start < width) ? count : start + width;
+            size_t end = (count - middle < width) ? count : middle + width;
+            size_t i = start;
+            size_t j = middle;
+            size_t k = start;
+            SORT_STATS_ADD(merges, 1);
+            SORT_STATS_ADD(nodeMoves, end - start);
+            while((i < middle) && (j < end)){
+                dst[k++] = SORT_COMPARE(compare, src[j].key, src[i].key) ? src[j++] : src[i++];
+            }
+            memcpy(dst + k, src + i, (middle - i) * sizeof(struct GatherPair));
+            k += middle - i;
+            memcpy(dst + k, src + j, (end - j) * sizeof(struct GatherPair));
+        }
+        struct GatherPair *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    return src;
+}
+
+/**
+ * \brief Gather the values, sort them and write them back in list order.
+ * The values and the buffer of the array sort are carved out of scratch, which
+ * grows to 2 * count elements, only a NULL scratch reserves temporary memory.
+ */
+static void gatherSortValues(struct List *list, IntegerCompareFunction compare, struct ArraySortScratch *scratch){
+    int32_t *ownValues = NULL;
+    int32_t *values;
+    struct ArraySortScratch rest = {0};
+    if(scratch != NULL){
+        values = arraySortScratchReserve(scratch, 2 * list->count);
+        /* The second half has room for the buffer of the sort, so it is never grown nor freed */
+        rest.buffer = values + list->count;
+        rest.capacity = list->count;
+    } else {
+        ownValues = (int32_t *) xzalloc(list->count, sizeof(int32_t));
+        values = ownValues;
+    }
+    struct ArraySortScratch *sortScratch = (scratch != NULL) ? &rest : NULL;
+    size_t count = 0;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        values[count++] = integerListNodeValue(node);
+    }
+    SORT_STATS_ADD(nodeMoves, count);
+
+    if(integerCompareIsAscending(compare)){
+        integerArrayRadixSort(values, count, sortScratch);
+    } else {
+        integerArrayMergeSort(values, count, compare, sortScratch);
+    }
+
+    count = 0;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        *(int32_t *) node->value = values[count++];
+    }
+    SORT_STATS_ADD(nodeMoves, count);
+    free(ownValues);
+}
+
+/**
+ * \brief Gather value and node pairs, sort them and relink the nodes in order
+ */
+static void gatherSortRelink(struct List *list, IntegerCompareFunction compare){
+    struct GatherPair *pairs = (struct GatherPair *) xzalloc(2 * list->count, sizeof(struct GatherPair));
+    struct GatherPair *buffer = pairs + list->count;
+    size_t count = 0;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        pairs[count].key = integerListNodeValue(node);
+        pairs[count].node = node;
+        count++;
+    }
+    SORT_STATS_ADD(nodeMoves, count);
+
+    struct GatherPair *sorted = integerCompareIsAscending(compare) ? pairRadixSort(pairs, buffer, count)
+                                                                 : pairMergeSort(pairs, buffer, count, compare);
+
+    struct ListNode *prev = NULL;
+    for(size_t i = 0; i < count; i++){
+        struct ListNode *node = sorted[i].node;
+        node->prev = prev;
+        if(prev != NULL) prev->next = node;
+        prev = node;
+    }
+    prev->next = NULL;
+    list->head = sorted[0].node;
+    list->tail = prev;
+    free(pairs);
+}
+
+enum ListReturnType integerListGatherSort(struct List *list, IntegerCompareFunction compare,
+                                          enum GatherSortMode mode, struct ArraySortScratch *scratch){
+    if(list == NULL) return RET_FAIL;
+    if(list->count <= 1) return RET_OK;
+    if((mode == GATHER_SORT_RELINK) || list->readOnly){
+        gatherSortRelink(list, compare);
+    } else {
+        gatherSortValues(list, compare, scratch);
+    }
+    integerListMarkSorted(list, compare);
+    return RET_OK;
+}
+
+void integerListHybridSort(struct List *list, IntegerCompareFunction compare){
+    if((list == NULL) || (list->count < gatherThreshold)){
+        integerListMergeSortInPlace(list, compare);
+    } else {
+        integerListGatherSort(list, compare, GATHER_SORT_VALUES, NULL);
+    }
+}
+
+void integerListGatherRelinkSort(struct List *list, IntegerCompareFunction compare){
+    integerListGatherSort(list, compare, GATHER_SORT_RELINK, NULL);
+}
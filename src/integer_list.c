@@ -1,4 +1,5 @@
 #include "integer_list.h"
+#include "node_pool.h"
 #include "utils.h"
 #include <stdio.h>
 
@@ -9,15 +10,48 @@ struct ListNode *integerListNodeCreate(int32_t value){
     return node;
 }
 
+struct ListNode *integerListInlineNodeCreate(int32_t value){
+    struct IntegerListNode *inode = (struct IntegerListNode *)xzalloc(1,sizeof(struct IntegerListNode));
+    inode->value = value;
+    inode->node.value = &inode->value;
+    return &inode->node;
+}
+
+void integerListFreeInlineNode(struct ListNode *node){
+    /* The value lives in the same allocation as the node */
+    free(node);
+}
+
+struct List* integerListCreateInline(void){
+    return listCreate(integerListFreeInlineNode);
+}
+
+struct List* integerListCreatePooled(size_t nodesPerBlock){
+    return listCreateWithPool(integerListFreeNode, nodePoolCreate(sizeof(int32_t), nodesPerBlock));
+}
+
+struct ListNode *integerListNodeCreateFor(struct List *list, int32_t value){
+    if(list->readOnly) return NULL;
+    if(list->pool == NULL) {
+        if(list->freeNode == integerListFreeInlineNode) return integerListInlineNodeCreate(value);
+        return integerListNodeCreate(value);
+    }
+    struct ListNode *node = nodePoolAlloc(list->pool);
+    *(int32_t *)node->value = value;
+    return node;
+}
+
 enum ListReturnType integerListAppendStart(struct List *list, int32_t value){
     if(list == NULL) return RET_FAIL;
-    struct ListNode *node = integerListNodeCreate(value);
+    struct ListNode *node = integerListNodeCreateFor(list, value);
+    if(node == NULL) return RET_FAIL;
     return listAppendStart(list, node);
 }
 
 enum ListReturnType integerListAppendEnd(struct List *list, int32_t value){
     if(list == NULL) return RET_FAIL;
-    struct ListNode *node = integerListNodeCreate(value);
+    struct ListNode *node = integerListNodeCreateFor(list, value);
+    if(node == NULL) return RET_FAIL;
     return listAppendEnd(list,node);
 }
 
@@ -34,6 +68,69 @@ struct List* integerListCreateWithElements(size_t count, int32_t elements[]) {
     return list;
 }
 
+struct List* integerListCreateBulk(size_t count, const int32_t elements[]) {
+    /* A single block holds every node next to its value, later nodes come in smaller blocks */
+    struct List *list = listCreateWithPool(integerListFreeNode,
+        nodePoolCreateWithFirstBlock(sizeof(int32_t), count, INTEGER_LIST_BULK_GROWTH));
+    struct ListNode *prev = NULL;
+    for(size_t i = 0; i < count; i++) {
+        struct ListNode *node = nodePoolAlloc(list->pool);
+        *(int32_t *)node->value = elements[i];
+        node->prev = prev;
+        if(prev != NULL) prev->next = node;
+        else list->head = node;
+        prev = node;
+    }
+    list->tail = prev;
+    list->count = count;
+    return list;
+}
+
+struct List* integerListCreateView(size_t count, const int32_t elements[]) {
+    /* The pool carries no payload, the nodes point into the array */
+    struct List *list = listCreateWithPool(NULL, nodePoolCreate(0, count));
+    struct ListNode *prev = NULL;
+    for(size_t i = 0; i < count; i++) {
+        struct ListNode *node = nodePoolAlloc(list->pool);
+        node->value = (void *) &elements[i];
+        node->prev = prev;
+        if(prev != NULL) prev->next = node;
+        else list->head = node;
+        prev = node;
+    }
+    list->tail = prev;
+    list->count = count;
+    list->readOnly = true;
+    return list;
+}
+
+struct List* integerListCreateInlineWithElements(size_t count, int32_t elements[]) {
+    struct List *list = integerListCreateInline();
+    for(size_t i=0; i<count; i++) {
+        integerListAppendEnd(list, elements[i]);
+    }
+    return list;
+}
+
+void integerListNodeSwapValues(struct ListNode *nodeA, struct ListNode *nodeB) {
+    if((nodeA == NULL) || (nodeB==NULL)) {
+        return;
+    }
+    int32_t tmp = *(int32_t *)nodeA->value;
+    *(int32_t *)nodeA->value = *(int32_t *)nodeB->value;
+    *(int32_t *)nodeB->value = tmp;
+}
+
+enum ListReturnType integerListSwapValues(struct List *list, struct ListNode *nodeA, struct ListNode *nodeB) {
+    /* The values of a view belong to the caller array or a read only mapping */
+    if((list == NULL) || (nodeA == NULL) || (nodeB == NULL) || list->readOnly) return RET_FAIL;
+    int32_t tmp = *(int32_t *)nodeA->value;
+    *(int32_t *)nodeA->value = *(int32_t *)nodeB->value;
+    *(int32_t *)nodeB->value = tmp;
+    list->sortedCount = 0;
+    return RET_OK;
+}
+
 bool integerListPrintElement(void *value, void *fmt) {
     if((value == NULL) || (fmt == NULL)){
         return false;
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include "utils.h"
 #include "list.h"
+#include "node_pool.h"
 #include <stdio.h>
 
 struct ListNode *listNodeCreate(void *value){
@@ -16,6 +17,40 @@ struct List* listCreate(ListFreeNodeCallback freeNode) {
     return list;
 }
 
+struct List* listCreateWithPool(ListFreeNodeCallback freeNode, struct NodePool *pool) {
+    struct List *list = listCreate(freeNode);
+    list->pool = pool;
+    return list;
+}
+
+void listNodeFree(struct List *list, struct ListNode *node){
+    if(node == NULL) return;
+    if(list->pool != NULL){
+        nodePoolFree(list->pool, node);
+    } else if(list->freeNode != NULL){
+        list->freeNode(node);
+    } else {
+        printf("freeNode was null\n");
+        free(node);
+    }
+}
+
+bool listCanMoveNodes(const struct List *list, const struct List *other){
+    if(list == other) return true;
+    return (list->pool == NULL) && (other->pool == NULL) && (list->freeNode == other->freeNode);
+}
+
+void listMarkSorted(struct List *list, size_t count, const void *order){
+    if(list == NULL) return;
+    list->sortedCount = (count < list->count) ? count : list->count;
+    list->sortedBy = order;
+}
+
+size_t listSortedCount(const struct List *list, const void *order){
+    if((list == NULL) || (list->sortedBy != order)) return 0;
+    return list->sortedCount;
+}
+
 enum ListReturnType listAppendStart(struct List *list, struct ListNode *node){
     if(list == NULL) return RET_FAIL;
     if(list->tail == NULL) { /* This should only happen when the list is empty */
@@ -28,6 +63,7 @@ enum ListReturnType listAppendStart(struct List *list, struct ListNode *node){
     list->head = node;
 
     list->count++;
+    list->sortedCount = 0;
     return RET_OK;
 }
 
@@ -50,6 +86,8 @@ enum ListReturnType listInsertAfter(struct List* list, struct ListNode *previous
     if(previous == NULL) return RET_FAIL;
     if(list->tail == previous) {
         list->tail = node;
+    } else {
+        list->sortedCount = 0;
     }
     if(previous->next!=NULL){
         previous->next->prev = node;
@@ -72,9 +110,11 @@ enum ListReturnType listInsertBefore(struct List* list, struct ListNode *next, s
     if(next->prev!=NULL){
         next->prev->next = node;
     }
+    node->prev = next->prev;
     node->next = next;
     next->prev = node;
     list->count++;
+    list->sortedCount = 0;
     return RET_OK;
 }
 
@@ -93,19 +133,35 @@ struct ListNode *listPop(struct List *list){
     node->next = NULL;
     node->prev = NULL;
     list->count--;
+    if(list->sortedCount > 0) list->sortedCount--;
     return node;
 }
 
+enum ListReturnType listRemove(struct List *list, struct ListNode *node){
+    if((list == NULL) || (node == NULL) || (list->count == 0)) return RET_FAIL;
+    if(node->prev != NULL) node->prev->next = node->next;
+    else list->head = node->next;
+    if(node->next != NULL) node->next->prev = node->prev;
+    else list->tail = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+    list->count--;
+    /* Whether the node was in the sorted prefix or not, one less element stays sorted */
+    if(list->sortedCount > 0) list->sortedCount--;
+    return RET_OK;
+}
+
 void listDestroy(struct List *list){
+    if(list->pool != NULL){
+        /* All the nodes live in the pool blocks, release them at once */
+        nodePoolDestroy(list->pool);
+        free(list);
+        return;
+    }
     /* Fist free all elements */
     struct ListNode *node = listPop(list);
     while(node != NULL){
-        if(list->freeNode != NULL){
-            list->freeNode(node);
-        } else {
-            printf("freeNode was null\n");
-            free(node);
-        }
+        listNodeFree(list, node);
         node = listPop(list);
     }
     /* Then free the list */
@@ -132,3 +188,11 @@ void listNodeSwapValues(struct ListNode *nodeA, struct ListNode *nodeB) {
     nodeA->value = nodeB->value;
     nodeB->value = tmp;
 }
+
+void listSwapValues(struct List *list, struct ListNode *nodeA, struct ListNode *nodeB) {
+    if((list == NULL) || (nodeA == NULL) || (nodeB == NULL) || (nodeA == nodeB)) return;
+    void *tmp = nodeA->value;
+    nodeA->value = nodeB->value;
+    nodeB->value = tmp;
+    list->sortedCount = 0;
+}
@@ -1,5 +1,8 @@
 #include "integer_list.h"
 #include "merge_sort.h"
+#include "simd_sort.h"
+#include "sort_stats.h"
+#include "utils.h"
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -35,34 +38,172 @@ void multiListPrint(struct List *list){
     printf("\n}\n");
 }
 
-void integerListMergeSortMerge(struct List **right, struct List *left, IntegerCompareFunction compare){
-    struct ListNode *nodeA=NULL;
-    struct ListNode *nodeB=NULL;
-    nodeA = listPop(*right);
-    nodeB = listPop(left);
-    struct List *result = listCreate(integerListFreeNode);
-    while((nodeA != NULL) || (nodeB!=NULL)){
-        if(nodeA == NULL) {
-            listAppendEnd(result, nodeB);
-            nodeB = listPop(left);
-            continue;
-        } else if (nodeB == NULL){
-            listAppendEnd(result, nodeA);
-            nodeA = listPop(*right);
-            continue;
-        }
-        if(compare(*((int32_t *)nodeA->value), *((int32_t *)nodeB->value))) {
-            listAppendEnd(result,nodeA);
-            nodeA = listPop(*right);
+/* A run of linked nodes, NULL terminated through next and with valid prev links */
+struct NodeChain {
+    struct ListNode *head;
+    struct ListNode *tail;
+};
+
+/* Consecutive wins from one side before the merge switches to galloping, 0 disables it */
+static size_t minGallop = MERGE_SORT_DEFAULT_MIN_GALLOP;
+
+void integerListMergeSetMinGallop(size_t wins){
+    minGallop = wins;
+}
+
+/**
+ * \brief Tells if a node can be placed before the key in the merge.
+ * When strict is set, the node has to be strictly before the key, that is the
+ * rule for the second chain of a stable merge, otherwise ties are accepted.
+ */
+static inline bool gallopAccepts(struct ListNode *node, int32_t key, IntegerCompareFunction compare, bool strict){
+    int32_t value = integerListNodeValue(node);
+    return strict ? SORT_COMPARE(compare, value, key) : !SORT_COMPARE(compare, key, value);
+}
+
+struct ListNode *integerListGallop(struct ListNode *start, int32_t key, IntegerCompareFunction compare, bool strict){
+    if(!gallopAccepts(start, key, compare, strict)) return NULL;
+    struct ListNode *good = start;
+    size_t step = 1;
+    size_t span = 0; /* Unknown nodes between good and the first rejected probe */
+    for(;;){
+        struct ListNode *probe = good;
+        size_t i = 0;
+        while((i < step) && (probe->next != NULL)){
+            probe = probe->next;
+            i++;
+        }
+        if(i == 0) return good; /* End of the chain */
+        if(!gallopAccepts(probe, key, compare, strict)){
+            span = i - 1;
+            break;
+        }
+        good = probe;
+        if(i < step) return good; /* The probe reached the end of the chain */
+        step <<= 1;
+    }
+    while(span > 0){
+        size_t half = (span + 1) / 2;
+        struct ListNode *probe = good;
+        for(size_t i = 0; i < half; i++) probe = probe->next;
+        if(gallopAccepts(probe, key, compare, strict)){
+            good = probe;
+            span -= half;
+        } else {
+            span = half - 1;
+        }
+    }
+    return good;
+}
+
+/**
+ * \brief Merge 2 sorted chains of nodes by relinking them, no memory is reserved.
+ * The merge is stable: on ties the node from the first chain goes first. After
+ * minGallop consecutive wins from one chain, the winning segment is found with
+ * gallop and spliced into the result at once.
+ */
+static struct NodeChain mergeChains(struct NodeChain a, struct NodeChain b, IntegerCompareFunction compare){
+    if(a.head == NULL) return b;
+    if(b.head == NULL) return a;
+    SORT_STATS_ADD(merges, 1);
+    struct ListNode dummy = {0};
+    struct ListNode *tail = &dummy;
+    struct ListNode *nodeA = a.head;
+    struct ListNode *nodeB = b.head;
+    size_t winsA = 0;
+    size_t winsB = 0;
+    while((nodeA != NULL) && (nodeB != NULL)){
+        struct ListNode *first;
+        struct ListNode *last;
+        if(SORT_COMPARE(compare, integerListNodeValue(nodeB), integerListNodeValue(nodeA))) {
+            first = nodeB;
+            last = nodeB;
+            winsA = 0;
+            if((minGallop != 0) && (++winsB >= minGallop) && (nodeB->next != NULL)) {
+                struct ListNode *end = integerListGallop(nodeB->next, integerListNodeValue(nodeA), compare, true);
+                if(end != NULL) last = end;
+                winsB = 0;
+            }
+            nodeB = last->next;
         } else {
-            listAppendEnd(result, nodeB);
-            nodeB = listPop(left);
+            first = nodeA;
+            last = nodeA;
+            winsB = 0;
+            if((minGallop != 0) && (++winsA >= minGallop) && (nodeA->next != NULL)) {
+                struct ListNode *end = integerListGallop(nodeA->next, integerListNodeValue(nodeB), compare, false);
+                if(end != NULL) last = end;
+                winsA = 0;
+            }
+            nodeA = last->next;
         }
+        /* Splice the segment first..last, its inner links are already right */
+        SORT_STATS_ADD(nodeMoves, 1);
+        tail->next = first;
+        first->prev = tail;
+        tail = last;
     }
-    /* Destroy the input lists and leave the result in the right list */
-    listDestroy(*right);
-    *right = result;
+    /* One of the chains is exhausted, the other one is appended as it is */
+    struct NodeChain result;
+    if(nodeA != NULL) {
+        tail->next = nodeA;
+        nodeA->prev = tail;
+        result.tail = a.tail;
+    } else {
+        tail->next = nodeB;
+        nodeB->prev = tail;
+        result.tail = b.tail;
+    }
+    result.head = dummy.next;
+    result.head->prev = NULL;
+    return result;
+}
+
+/**
+ * \brief Make the nodes of other safe to be linked into list. When listNodeFree
+ * would free them differently on both lists, the values are copied into nodes
+ * created for list and the nodes of other are freed, keeping the order. other
+ * holds the new nodes afterwards, so it must be emptied before it is destroyed.
+ * \return RET_OK, or RET_FAIL if the values would have to be copied into a readOnly list.
+ */
+static enum ListReturnType mergeTakeNodes(struct List *list, struct List *other){
+    if((other->head == NULL) || listCanMoveNodes(list, other)) return RET_OK;
+    if(list->readOnly) return RET_FAIL;
+    struct ListNode dummy = {0};
+    struct ListNode *tail = &dummy;
+    struct ListNode *node = other->head;
+    while(node != NULL){
+        struct ListNode *next = node->next;
+        struct ListNode *copy = integerListNodeCreateFor(list, integerListNodeValue(node));
+        SORT_STATS_ADD(nodeMoves, 1);
+        tail->next = copy;
+        copy->prev = tail;
+        tail = copy;
+        listNodeFree(other, node);
+        node = next;
+    }
+    other->head = dummy.next;
+    other->head->prev = NULL;
+    other->tail = tail;
+    return RET_OK;
+}
+
+enum ListReturnType integerListMergeSortMerge(struct List **right, struct List *left, IntegerCompareFunction compare){
+    struct List *result = *right;
+    /* The nodes of left are destroyed with it unless they are moved or copied first */
+    if(mergeTakeNodes(result, left) != RET_OK) return RET_FAIL;
+    struct NodeChain a = { .head = result->head, .tail = result->tail };
+    struct NodeChain b = { .head = left->head, .tail = left->tail };
+    struct NodeChain merged = mergeChains(a, b, compare);
+    result->head = merged.head;
+    result->tail = merged.tail;
+    result->count += left->count;
+    integerListMarkSorted(result, compare);
+    /* All the nodes were moved to the right list, destroy the empty left list */
+    left->head = NULL;
+    left->tail = NULL;
+    left->count = 0;
     listDestroy(left);
+    return RET_OK;
 }
 
 void integerListMergeSort(struct List *list, IntegerCompareFunction compare) {
@@ -72,6 +213,7 @@ void integerListMergeSort(struct List *list, IntegerCompareFunction compare) {
     struct List *integerMultiList = multiListCreate();
 
     /* Initialize the list of lists O(n)*/
+    SORT_STATS_TIMER_START(splitStart);
     struct ListNode *node = listPop(list);
     while(node != NULL){
         struct ListNode *tlist = integerMultiListNodeCreate();
@@ -79,9 +221,12 @@ void integerListMergeSort(struct List *list, IntegerCompareFunction compare) {
         listAppendEnd(integerMultiList, tlist);
         node = listPop(list);
     }
+    SORT_STATS_TIMER_STOP(splitNs, splitStart);
 
     /* Take 2 lists and merge them, store the result to be used in the nexr iteration*/
+    SORT_STATS_TIMER_START(mergeStart);
     while(integerMultiList->count > 1) {
+        SORT_STATS_ADD(mergePasses, 1);
         struct ListNode *aList = listPop(integerMultiList);
         struct List* nextIntegerMultiList = multiListCreate(); /*Temporary list to hold the result */
         while(aList != NULL){
@@ -101,8 +246,10 @@ void integerListMergeSort(struct List *list, IntegerCompareFunction compare) {
         listDestroy(integerMultiList); /*This list should be empty already, free it */
         integerMultiList = nextIntegerMultiList; /* Update the integerMultiList for the next cycle */
     }
+    SORT_STATS_TIMER_STOP(mergeNs, mergeStart);
 
     /* Copy the result to the original list O(n)*/
+    SORT_STATS_TIMER_START(copyBackStart);
     struct ListNode *rNode = listPop(integerMultiList);
     struct List *rList = (struct List*) rNode->value;
     node = listPop(rList);
@@ -115,24 +262,458 @@ void integerListMergeSort(struct List *list, IntegerCompareFunction compare) {
     free(rNode);
     listDestroy(integerMultiList);
     integerMultiList = NULL;
+    SORT_STATS_TIMER_STOP(copyBackNs, copyBackStart);
+    integerListMarkSorted(list, compare);
+}
+
+/**
+ * \brief Tells if the current node of list a wins against the current node of list b
+ * in the loser tree. Empty lists always lose, on ties the list with the lower index
+ * wins so the merge is stable.
+ */
+static inline bool loserTreeWins(struct ListNode **cursors, size_t a, size_t b, IntegerCompareFunction compare){
+    if(cursors[a] == NULL) return false;
+    if(cursors[b] == NULL) return true;
+    if(a < b) return !SORT_COMPARE(compare, integerListNodeValue(cursors[b]), integerListNodeValue(cursors[a]));
+    return SORT_COMPARE(compare, integerListNodeValue(cursors[a]), integerListNodeValue(cursors[b]));
+}
+
+enum ListReturnType integerListMergeMany(struct List **lists, size_t count, IntegerCompareFunction compare){
+    if((lists == NULL) || (count == 0)) return RET_FAIL;
+    if(count == 1) return RET_OK;
+    /* Check every list before modifying any of them */
+    for(size_t i = 1; i < count; i++){
+        if(lists[0]->readOnly && (lists[i]->count > 0) && !listCanMoveNodes(lists[0], lists[i])) return RET_FAIL;
+    }
+    for(size_t i = 1; i < count; i++) mergeTakeNodes(lists[0], lists[i]);
+    SORT_STATS_ADD(merges, 1);
+
+    /* cursors[i] is the next node of list i, tree[i] the loser of the internal node i and tree[0] the winner */
+    struct ListNode **cursors = (struct ListNode **) xzalloc(count, sizeof(struct ListNode *));
+    size_t *tree = (size_t *) xzalloc(count, sizeof(size_t));
+    size_t *winners = (size_t *) xzalloc(2 * count, sizeof(size_t));
+    size_t total = 0;
+    for(size_t i = 0; i < count; i++){
+        cursors[i] = lists[i]->head;
+        total += lists[i]->count;
+        winners[count + i] = i;
+    }
+
+    /* Build the tree bottom up, the leaf of list i is the node count+i */
+    for(size_t node = count - 1; node > 0; node--){
+        size_t left = winners[2 * node];
+        size_t right = winners[2 * node + 1];
+        if(loserTreeWins(cursors, left, right, compare)){
+            winners[node] = left;
+            tree[node] = right;
+        } else {
+            winners[node] = right;
+            tree[node] = left;
+        }
+    }
+    tree[0] = winners[1];
+    free(winners);
+
+    struct ListNode dummy = {0};
+    struct ListNode *tail = &dummy;
+    while(cursors[tree[0]] != NULL){
+        size_t winner = tree[0];
+        struct ListNode *node = cursors[winner];
+        cursors[winner] = node->next;
+        tail->next = node;
+        node->prev = tail;
+        tail = node;
+        SORT_STATS_ADD(nodeMoves, 1);
+
+        /* Replay the matches from the leaf of the winner to the root, log2(count) comparisons */
+        for(size_t parent = (winner + count) / 2; parent > 0; parent /= 2){
+            if(loserTreeWins(cursors, tree[parent], winner, compare)){
+                size_t tmp = tree[parent];
+                tree[parent] = winner;
+                winner = tmp;
+            }
+        }
+        tree[0] = winner;
+    }
+    tail->next = NULL;
+
+    for(size_t i = 0; i < count; i++){
+        lists[i]->head = NULL;
+        lists[i]->tail = NULL;
+        lists[i]->count = 0;
+        lists[i]->sortedCount = 0;
+    }
+    if(total > 0){
+        lists[0]->head = dummy.next;
+        lists[0]->head->prev = NULL;
+        lists[0]->tail = tail;
+        lists[0]->count = total;
+        integerListMarkSorted(lists[0], compare);
+    }
+    free(tree);
+    free(cursors);
+    return RET_OK;
+}
+
+/* Enough bins for any list that fits in memory, bin i holds a sorted run of 2^i nodes */
+#define MERGE_SORT_MAX_BINS (sizeof(size_t) * 8)
+
+/**
+ * \brief Detach up to SIMD_SORT_BLOCK_SIZE nodes starting at *node and relink
+ * them in ascending order. The values are sorted by the sorting network kernel,
+ * then every node, in its original order, takes the next free place of the
+ * group of its value, found with a binary search, so the order is stable and
+ * the values stay in their nodes.
+ * \param node First node of the block, updated to the node after the block.
+ * \return     The sorted chain of nodes.
+ */
+static struct NodeChain takeSortedBlock(struct ListNode **node){
+    int32_t values[SIMD_SORT_BLOCK_SIZE];
+    struct ListNode *nodes[SIMD_SORT_BLOCK_SIZE];
+    struct ListNode *sorted[SIMD_SORT_BLOCK_SIZE];
+    uint8_t taken[SIMD_SORT_BLOCK_SIZE] = {0};
+    size_t count = 0;
+    for(struct ListNode *it = *node; (it != NULL) && (count < SIMD_SORT_BLOCK_SIZE); it = it->next){
+        nodes[count] = it;
+        values[count] = integerListNodeValue(it);
+        count++;
+    }
+    *node = nodes[count - 1]->next;
+    int32SortBlock(values, count);
+
+    for(size_t i = 0; i < count; i++){
+        int32_t value = integerListNodeValue(nodes[i]);
+        size_t low = 0;
+        size_t high = count;
+        while(low < high){
+            size_t middle = (low + high) / 2;
+            if(values[middle] < value){
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        sorted[low + taken[low]++] = nodes[i];
+    }
+    SORT_STATS_ADD(nodeMoves, count);
+
+    struct NodeChain block = { .head = sorted[0], .tail = sorted[count - 1] };
+    struct ListNode *prev = NULL;
+    for(size_t i = 0; i < count; i++){
+        sorted[i]->prev = prev;
+        if(prev != NULL) prev->next = sorted[i];
+        prev = sorted[i];
+    }
+    block.tail->next = NULL;
+    return block;
+}
+
+void integerListMergeSortInPlace(struct List *list, IntegerCompareFunction compare) {
+    if((list == NULL) || (list->count <= 1)) return;
+
+    struct NodeChain bins[MERGE_SORT_MAX_BINS] = {{0}};
+    size_t usedBins = 0;
+
+    /* Feed the nodes one by one, carrying merges like a binary counter O(n log n).
+     * The default ascending order starts from blocks relinked in the order found
+     * by the kernel instead. */
+    bool useBlocks = integerCompareIsAscending(compare);
+    struct ListNode *node = list->head;
+    while(node != NULL){
+        struct NodeChain carry;
+        struct ListNode *next;
+        if(useBlocks){
+            carry = takeSortedBlock(&node);
+            next = node;
+        } else {
+            next = node->next;
+            node->next = NULL;
+            node->prev = NULL;
+            carry = (struct NodeChain) { .head = node, .tail = node };
+        }
+        size_t i = 0;
+        while(bins[i].head != NULL){
+            /* bins[i] holds older nodes, keep it first for stability */
+            carry = mergeChains(bins[i], carry, compare);
+            bins[i].head = NULL;
+            bins[i].tail = NULL;
+            i++;
+        }
+        bins[i] = carry;
+        if(i >= usedBins) usedBins = i + 1;
+        node = next;
+    }
+
+    /* Merge the remaining bins, higher bins contain the older nodes */
+    struct NodeChain result = {0};
+    for(size_t i = 0; i < usedBins; i++){
+        if(bins[i].head == NULL) continue;
+        result = (result.head == NULL) ? bins[i] : mergeChains(bins[i], result, compare);
+    }
+
+    list->head = result.head;
+    list->tail = result.tail;
+    integerListMarkSorted(list, compare);
+}
+
+/* Runs shorter than this are extended with insertion sort before merging them */
+#define MERGE_SORT_MIN_RUN 32
+/* With the stack invariants kept, the run lengths grow faster than fibonacci numbers */
+#define MERGE_SORT_MAX_RUNS 85
+
+struct SortRun {
+    struct NodeChain chain;
+    size_t length;
+};
+
+/**
+ * \brief Computes the minimum run length like TimSort does, a value between
+ * MERGE_SORT_MIN_RUN/2 and MERGE_SORT_MIN_RUN such that count/minRun is close
+ * to a power of 2 so the final merges are balanced.
+ */
+static size_t computeMinRun(size_t count){
+    size_t r = 0;
+    while(count >= MERGE_SORT_MIN_RUN){
+        r |= count & 1;
+        count >>= 1;
+    }
+    return count + r;
+}
+
+/**
+ * \brief Detach the next natural run starting at node.
+ * Ascending runs are taken as they are and strictly descending runs are reversed,
+ * since no equal elements exist in them, reversing keeps the sort stable.
+ * Short runs are extended up to minRun nodes with a stable insertion sort.
+ * \param node   First node of the run
+ * \param run    Output run, detached from the remaining nodes
+ * \return       The first node after the run or NULL at the end of the list
+ */
+static struct ListNode *takeRun(struct ListNode *node, size_t minRun, IntegerCompareFunction compare, struct SortRun *run){
+    struct ListNode *last = node;
+    size_t length = 1;
+    if((node->next != NULL) && SORT_COMPARE(compare, integerListNodeValue(node->next), integerListNodeValue(node))) {
+        while((last->next != NULL) && SORT_COMPARE(compare, integerListNodeValue(last->next), integerListNodeValue(last))){
+            last = last->next;
+            length++;
+        }
+        struct ListNode *rest = last->next;
+        /* Reverse the descending run */
+        struct ListNode *itr = node;
+        while(itr != rest){
+            struct ListNode *next = itr->next;
+            itr->next = itr->prev;
+            itr->prev = next;
+            itr = next;
+        }
+        run->chain.head = last;
+        run->chain.tail = node;
+        node->next = rest;
+    } else {
+        while((last->next != NULL) && !SORT_COMPARE(compare, integerListNodeValue(last->next), integerListNodeValue(last))){
+            last = last->next;
+            length++;
+        }
+        run->chain.head = node;
+        run->chain.tail = last;
+    }
+    run->chain.head->prev = NULL;
+    struct ListNode *rest = run->chain.tail->next;
+    run->chain.tail->next = NULL;
+
+    /* Extend the run with an insertion sort, walking from the tail keeps it stable */
+    while((length < minRun) && (rest != NULL)){
+        struct ListNode *insert = rest;
+        rest = rest->next;
+        struct ListNode *after = run->chain.tail;
+        while((after != NULL) && SORT_COMPARE(compare, integerListNodeValue(insert), integerListNodeValue(after))){
+            after = after->prev;
+        }
+        SORT_STATS_ADD(nodeMoves, 1);
+        insert->prev = after;
+        if(after == NULL){
+            insert->next = run->chain.head;
+            run->chain.head->prev = insert;
+            run->chain.head = insert;
+        } else {
+            insert->next = after->next;
+            if(after->next != NULL){
+                after->next->prev = insert;
+            } else {
+                run->chain.tail = insert;
+            }
+            after->next = insert;
+        }
+        length++;
+    }
+    run->length = length;
+    return rest;
+}
+
+/**
+ * \brief Merge the runs at position i and i+1 of the stack, leaving the result at i.
+ */
+static void mergeRunsAt(struct SortRun *runs, size_t *stackSize, size_t i, IntegerCompareFunction compare){
+    runs[i].chain = mergeChains(runs[i].chain, runs[i + 1].chain, compare);
+    runs[i].length += runs[i + 1].length;
+    for(size_t j = i + 1; j + 1 < *stackSize; j++){
+        runs[j] = runs[j + 1];
+    }
+    (*stackSize)--;
+}
+
+/**
+ * \brief Merge the runs in the stack until the TimSort invariants hold again:
+ * len[n-2] > len[n-1] + len[n] and len[n-1] > len[n].
+ */
+static void collapseRuns(struct SortRun *runs, size_t *stackSize, IntegerCompareFunction compare){
+    while(*stackSize > 1){
+        size_t n = *stackSize - 2;
+        if(((n > 0) && (runs[n - 1].length <= runs[n].length + runs[n + 1].length)) ||
+           ((n > 1) && (runs[n - 2].length <= runs[n - 1].length + runs[n].length))) {
+            if(runs[n - 1].length < runs[n + 1].length) n--;
+        } else if(runs[n].length > runs[n + 1].length) {
+            break;
+        }
+        mergeRunsAt(runs, stackSize, n, compare);
+    }
+}
+
+void integerListNaturalMergeSort(struct List *list, IntegerCompareFunction compare) {
+    if((list == NULL) || (list->count <= 1)) return;
+
+    struct SortRun runs[MERGE_SORT_MAX_RUNS];
+    size_t stackSize = 0;
+    size_t minRun = computeMinRun(list->count);
+
+    struct ListNode *node = list->head;
+    while(node != NULL){
+        node = takeRun(node, minRun, compare, &runs[stackSize]);
+        stackSize++;
+        collapseRuns(runs, &stackSize, compare);
+    }
+
+    /* Force the remaining merges */
+    while(stackSize > 1){
+        size_t n = stackSize - 2;
+        if((n > 0) && (runs[n - 1].length < runs[n + 1].length)) n--;
+        mergeRunsAt(runs, &stackSize, n, compare);
+    }
+
+    list->head = runs[0].chain.head;
+    list->tail = runs[0].chain.tail;
+    integerListMarkSorted(list, compare);
+}
+
+size_t integerListSortedPrefix(const struct List *list, IntegerCompareFunction compare) {
+    size_t recorded = listSortedCount(list, (const void *) compare);
+    if(recorded == 0) return 0;
+    size_t sorted = 1;
+    for(struct ListNode *node = list->head; (sorted < recorded) && (node->next != NULL); node = node->next){
+        if(SORT_COMPARE(compare, integerListNodeValue(node->next), integerListNodeValue(node))) break;
+        sorted++;
+    }
+    return sorted;
+}
+
+void integerListIncrementalSort(struct List *list, IntegerCompareFunction compare) {
+    if(list == NULL) return;
+    size_t sorted = integerListSortedPrefix(list, compare);
+    if(sorted >= list->count){
+        integerListMarkSorted(list, compare);
+        return;
+    }
+    if(sorted == 0){
+        integerListMergeSortInPlace(list, compare);
+        return;
+    }
+
+    /* Detach the unsorted suffix walking back from the tail O(m) */
+    size_t suffixCount = list->count - sorted;
+    struct ListNode *first = list->tail;
+    for(size_t i = 1; i < suffixCount; i++) first = first->prev;
+    struct NodeChain prefix = { .head = list->head, .tail = first->prev };
+    prefix.tail->next = NULL;
+    first->prev = NULL;
+
+    struct List suffix = { .head = first, .tail = list->tail, .count = suffixCount, .readOnly = list->readOnly };
+    integerListMergeSortInPlace(&suffix, compare);
+
+    /* The prefix holds the older nodes, keep it first for stability */
+    struct NodeChain rest = { .head = suffix.head, .tail = suffix.tail };
+    struct NodeChain result = mergeChains(prefix, rest, compare);
+    list->head = result.head;
+    list->tail = result.tail;
+    integerListMarkSorted(list, compare);
+}
+
+void integerListInsertionSort(struct List *list, IntegerCompareFunction compare) {
+    if((list == NULL) || (list->head == NULL)) return;
+    struct ListNode *node = list->head->next;
+    while(node != NULL){
+        struct ListNode *next = node->next;
+        int32_t value = integerListNodeValue(node);
+        struct ListNode *position = node->prev;
+        while((position != NULL) && SORT_COMPARE(compare, value, integerListNodeValue(position))){
+            position = position->prev;
+        }
+        if(position != node->prev){
+            /* Unlink the node and relink it after position, or as the new head */
+            node->prev->next = next;
+            if(next != NULL) next->prev = node->prev;
+            else list->tail = node->prev;
+            struct ListNode *after = (position != NULL) ? position->next : list->head;
+            node->prev = position;
+            node->next = after;
+            after->prev = node;
+            if(position != NULL) position->next = node;
+            else list->head = node;
+            SORT_STATS_ADD(nodeMoves, 1);
+        }
+        node = next;
+    }
+    integerListMarkSorted(list, compare);
 }
 
 void naiveSort(struct List *list, IntegerCompareFunction compare) {
+    if(list->readOnly) {
+        /* The values can not be swapped, relink the nodes instead */
+        integerListInsertionSort(list, compare);
+        return;
+    }
     struct ListNode *pivot = list->head;
     //if(pivot == NULL) return;
     while(pivot!=NULL){
         struct ListNode *itr = pivot->next;
         while(itr!=NULL){
-            if(!compare(*(int32_t*)pivot->value, *(int32_t*)itr->value)){
-                listNodeSwapValues(pivot,itr);
+            if(!SORT_COMPARE(compare, integerListNodeValue(pivot), integerListNodeValue(itr))){
+                integerListSwapValues(list, pivot, itr);
+                SORT_STATS_ADD(nodeMoves, 2);
             }
             itr = itr->next;
         }
         pivot = pivot->next;
     }
+    integerListMarkSorted(list, compare);
 }
 
-bool earessThan(int32_t a, int32_t b) {
+bool lessThan(int32_t a, int32_t b) {
     return a < b;
 }
 
+/* Compare function declared to order like lessThan, read from the sorting threads as well */
+static IntegerCompareFunction *ascendingCompare = NULL;
+
+void integerCompareSetAscending(IntegerCompareFunction *compare){
+    __atomic_store_n(&ascendingCompare, compare, __ATOMIC_RELEASE);
+}
+
+bool integerCompareIsAscending(IntegerCompareFunction *compare){
+    return (compare == lessThan) ||
+           ((compare != NULL) && (compare == __atomic_load_n(&ascendingCompare, __ATOMIC_ACQUIRE)));
+}
+
+
+bool greaterThan(int32_t a, int32_t b) {
+    return a > b;
+}
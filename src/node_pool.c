@@ -0,0 +1,84 @@
+#include "node_pool.h"
+#include "utils.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Slots are aligned for pointers, 64 bit integers and doubles stored as payload */
+#define NODE_POOL_ALIGNMENT sizeof(void *)
+
+struct NodePoolBlock {
+    struct NodePoolBlock *next;    /* Previously reserved block */
+    char slots[];                  /* Memory carved into nodes */
+};
+
+/**
+ * \brief Offset of the payload from the start of a slot
+ */
+static size_t nodePoolPayloadOffset(void){
+    return (sizeof(struct ListNode) + NODE_POOL_ALIGNMENT - 1) & ~(NODE_POOL_ALIGNMENT - 1);
+}
+
+/**
+ * \brief Reserve a new current block for slots nodes
+ */
+static void nodePoolReserveBlock(struct NodePool *pool, size_t slots){
+    /* xzalloc returns zeroed memory, the new slots do not need to be cleared */
+    struct NodePoolBlock *block = (struct NodePoolBlock *) xzalloc(1,
+        sizeof(struct NodePoolBlock) + slots * pool->slotSize);
+    block->next = pool->blocks;
+    pool->blocks = block;
+    pool->blockCount++;
+    pool->blockSlots = slots;
+    pool->usedSlots = 0;
+}
+
+struct NodePool *nodePoolCreate(size_t payloadSize, size_t slotsPerBlock){
+    return nodePoolCreateWithFirstBlock(payloadSize, 0, slotsPerBlock);
+}
+
+struct NodePool *nodePoolCreateWithFirstBlock(size_t payloadSize, size_t firstBlockSlots, size_t slotsPerBlock){
+    struct NodePool *pool = (struct NodePool *) xzalloc(1, sizeof(struct NodePool));
+    size_t slotSize = nodePoolPayloadOffset() + payloadSize;
+    pool->payloadSize = payloadSize;
+    pool->slotSize = (slotSize + NODE_POOL_ALIGNMENT - 1) & ~(NODE_POOL_ALIGNMENT - 1);
+    pool->slotsPerBlock = (slotsPerBlock > 0) ? slotsPerBlock : 1;
+    /* Without a first block the current one is empty, forcing a block to be reserved on the first allocation */
+    if(firstBlockSlots > 0) nodePoolReserveBlock(pool, firstBlockSlots);
+    return pool;
+}
+
+struct ListNode *nodePoolAlloc(struct NodePool *pool){
+    struct ListNode *node;
+    if(pool->freeList != NULL){
+        node = pool->freeList;
+        pool->freeList = node->next;
+        memset(node, 0, pool->slotSize);
+    } else {
+        if(pool->usedSlots == pool->blockSlots) nodePoolReserveBlock(pool, pool->slotsPerBlock);
+        node = (struct ListNode *) (pool->blocks->slots + pool->usedSlots * pool->slotSize);
+        pool->usedSlots++;
+    }
+    if(pool->payloadSize > 0){
+        node->value = (char *) node + nodePoolPayloadOffset();
+    }
+    return node;
+}
+
+void nodePoolFree(struct NodePool *pool, struct ListNode *node){
+    if((pool == NULL) || (node == NULL)) return;
+    node->prev = NULL;
+    node->next = pool->freeList;
+    pool->freeList = node;
+}
+
+void nodePoolDestroy(struct NodePool *pool){
+    if(pool == NULL) return;
+    struct NodePoolBlock *block = pool->blocks;
+    while(block != NULL){
+        struct NodePoolBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(pool);
+}
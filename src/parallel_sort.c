@@ -0,0 +1,465 @@
+#include "parallel_sort.h"
+#include "gather_sort.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * \brief Data type for a unit of work run by the worker threads
+ */
+typedef void ParallelTaskFunction(void *task);
+
+struct ParallelWorker {
+    ParallelTaskFunction *run; /* Function run for every task */
+    char *tasks;               /* Array of tasks shared by all the workers */
+    size_t taskSize;           /* Size of every task in bytes */
+    size_t taskCount;          /* Amount of tasks in the array */
+    size_t first;              /* First task run by this worker */
+    size_t stride;             /* Distance between the tasks run by this worker */
+    struct SortStats stats;    /* Statistics of the worker thread, added to the caller when it ends */
+};
+
+static void *parallelWorkerMain(void *arg){
+    struct ParallelWorker *worker = (struct ParallelWorker *) arg;
+    for(size_t i = worker->first; i < worker->taskCount; i += worker->stride){
+        worker->run(worker->tasks + i * worker->taskSize);
+    }
+    sortStatsGet(&worker->stats);
+    return NULL;
+}
+
+/**
+ * \brief Run an array of tasks spread over the given amount of threads.
+ * The calling thread works as one of the threads. If a thread can not be
+ * created, its tasks are run by the calling thread.
+ */
+static void runParallel(ParallelTaskFunction *run, void *tasks, size_t taskSize, size_t taskCount, size_t threads){
+    if(threads > taskCount) threads = taskCount;
+    if(threads == 0) return;
+
+    struct ParallelWorker *workers = (struct ParallelWorker *) xzalloc(threads, sizeof(struct ParallelWorker));
+    pthread_t *ids = (pthread_t *) xzalloc(threads, sizeof(pthread_t));
+    bool *started = (bool *) xzalloc(threads, sizeof(bool));
+    for(size_t t = 0; t < threads; t++){
+        workers[t].run = run;
+        workers[t].tasks = (char *) tasks;
+        workers[t].taskSize = taskSize;
+        workers[t].taskCount = taskCount;
+        workers[t].first = t;
+        workers[t].stride = threads;
+    }
+    for(size_t t = 1; t < threads; t++){
+        started[t] = (pthread_create(&ids[t], NULL, parallelWorkerMain, &workers[t]) == 0);
+    }
+    parallelWorkerMain(&workers[0]);
+    for(size_t t = 1; t < threads; t++){
+        if(started[t]){
+            pthread_join(ids[t], NULL);
+            sortStatsAccumulate(&workers[t].stats);
+        } else {
+            parallelWorkerMain(&workers[t]);
+        }
+    }
+    free(started);
+    free(ids);
+    free(workers);
+}
+
+size_t parallelSortDefaultThreads(void){
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return (processors > 0) ? (size_t) processors : 1;
+}
+
+/**
+ * \brief Amount of parts an input of count elements is split into
+ */
+static size_t parallelSortParts(size_t count, size_t threads, size_t serialCutoff){
+    if(threads == 0) threads = parallelSortDefaultThreads();
+    if(serialCutoff == 0) serialCutoff = 1;
+    size_t parts = count / serialCutoff;
+    return (parts > threads) ? threads : parts;
+}
+
+/****************************  Lists  *****************************/
+
+struct ListSortTask {
+    struct List *list;                /* List sorted by the task, it holds the merge result */
+    struct List *other;               /* List merged into list, NULL for sort tasks */
+    IntegerCompareFunction *compare;
+};
+
+static void listSortTask(void *arg){
+    struct ListSortTask *task = (struct ListSortTask *) arg;
+    integerListMergeSortInPlace(task->list, task->compare);
+}
+
+static void listMergeTask(void *arg){
+    struct ListSortTask *task = (struct ListSortTask *) arg;
+    integerListMergeSortMerge(&task->list, task->other, task->compare);
+}
+
+void integerListParallelMergeSort(struct List *list, IntegerCompareFunction compare, size_t threads, size_t serialCutoff){
+    if((list == NULL) || (list->count <= 1)) return;
+    if(threads == 0) threads = parallelSortDefaultThreads();
+    size_t parts = parallelSortParts(list->count, threads, serialCutoff);
+    if(parts <= 1){
+        integerListMergeSortInPlace(list, compare);
+        return;
+    }
+
+    /* Split the list in sublists of roughly equal size O(n) */
+    struct ListSortTask *tasks = (struct ListSortTask *) xzalloc(parts, sizeof(struct ListSortTask));
+    struct ListNode *node = list->head;
+    size_t remaining = list->count;
+    for(size_t p = 0; p < parts; p++){
+        size_t size = remaining / (parts - p);
+        struct List *sublist = listCreate(list->freeNode);
+        sublist->head = node;
+        node->prev = NULL;
+        for(size_t i = 1; i < size; i++) node = node->next;
+        sublist->tail = node;
+        node = node->next;
+        sublist->tail->next = NULL;
+        sublist->count = size;
+        sublist->readOnly = list->readOnly;
+        remaining -= size;
+        tasks[p].list = sublist;
+        tasks[p].compare = compare;
+    }
+
+    runParallel(listSortTask, tasks, sizeof(struct ListSortTask), parts, threads);
+
+    /* Merge tree, every level merges pairs of neighbour sublists in parallel */
+    struct ListSortTask *merges = (struct ListSortTask *) xzalloc(parts / 2, sizeof(struct ListSortTask));
+    for(size_t step = 1; step < parts; step *= 2){
+        size_t mergeCount = 0;
+        for(size_t p = 0; p + step < parts; p += 2 * step){
+            merges[mergeCount].list = tasks[p].list;
+            merges[mergeCount].other = tasks[p + step].list;
+            merges[mergeCount].compare = compare;
+            mergeCount++;
+        }
+        runParallel(listMergeTask, merges, sizeof(struct ListSortTask), mergeCount, threads);
+        for(size_t m = 0; m < mergeCount; m++){
+            tasks[m * 2 * step].list = merges[m].list;
+        }
+    }
+
+    /* Move the result back to the original list */
+    struct List *sorted = tasks[0].list;
+    list->head = sorted->head;
+    list->tail = sorted->tail;
+    sorted->head = NULL;
+    sorted->tail = NULL;
+    sorted->count = 0;
+    listDestroy(sorted);
+    free(merges);
+    free(tasks);
+    integerListMarkSorted(list, compare);
+}
+
+void integerListParallelSort(struct List *list, IntegerCompareFunction compare){
+    integerListParallelMergeSort(list, compare, 0, PARALLEL_SORT_DEFAULT_CUTOFF);
+}
+
+/****************************  Arrays  ****************************/
+
+struct ArraySortTask {
+    int32_t *values;                  /* Chunk sorted by the task */
+    int32_t *scratch;                 /* Scratch memory reserved for this chunk */
+    size_t count;
+    IntegerCompareFunction *compare;
+};
+
+struct ArrayMergeTask {
+    const int32_t *left;
+    size_t leftCount;
+    const int32_t *right;
+    size_t rightCount;
+    int32_t *dst;
+    IntegerCompareFunction *compare;
+};
+
+static void arraySortTask(void *arg){
+    struct ArraySortTask *task = (struct ArraySortTask *) arg;
+    struct ArraySortScratch scratch = { .buffer = task->scratch, .capacity = task->count };
+    integerArrayMergeSort(task->values, task->count, task->compare, &scratch);
+}
+
+static void arrayMergeTask(void *arg){
+    struct ArrayMergeTask *task = (struct ArrayMergeTask *) arg;
+    integerArrayMerge(task->left, task->leftCount, task->right, task->rightCount, task->dst, task->compare);
+}
+
+/**
+ * \brief Find how many elements of left are among the first diagonal elements
+ * of the stable merge of left and right (merge path), using a binary search.
+ */
+static size_t mergePathSplit(const int32_t *left, size_t leftCount, const int32_t *right, size_t rightCount,
+                             size_t diagonal, IntegerCompareFunction compare){
+    size_t lo = (diagonal > rightCount) ? diagonal - rightCount : 0;
+    size_t hi = (diagonal < leftCount) ? diagonal : leftCount;
+    while(lo < hi){
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = diagonal - i;
+        /* left[i] goes before right[j-1], so it belongs to the first part */
+        if((j > 0) && !SORT_COMPARE(compare, right[j - 1], left[i])){
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+void integerArrayParallelMergeSort(int32_t *values, size_t count, IntegerCompareFunction compare,
+                                   size_t threads, size_t serialCutoff, struct ArraySortScratch *scratch){
+    if(threads == 0) threads = parallelSortDefaultThreads();
+    size_t parts = parallelSortParts(count, threads, serialCutoff);
+    if(parts <= 1){
+        integerArrayMergeSort(values, count, compare, scratch);
+        return;
+    }
+
+    struct ArraySortScratch *ownScratch = NULL;
+    if(scratch == NULL){
+        ownScratch = arraySortScratchCreate(count);
+        scratch = ownScratch;
+    }
+    int32_t *buffer = arraySortScratchReserve(scratch, count);
+
+    /* Sort the chunks, bounds[p] is the first element of the chunk p */
+    size_t *bounds = (size_t *) xzalloc(parts + 1, sizeof(size_t));
+    struct ArraySortTask *sortTasks = (struct ArraySortTask *) xzalloc(parts, sizeof(struct ArraySortTask));
+    for(size_t p = 0; p <= parts; p++){
+        bounds[p] = (count / parts) * p + ((count % parts) * p) / parts;
+    }
+    for(size_t p = 0; p < parts; p++){
+        sortTasks[p].values = values + bounds[p];
+        sortTasks[p].scratch = buffer + bounds[p];
+        sortTasks[p].count = bounds[p + 1] - bounds[p];
+        sortTasks[p].compare = compare;
+    }
+    runParallel(arraySortTask, sortTasks, sizeof(struct ArraySortTask), parts, threads);
+
+    /* Merge tree, every level splits its output evenly between all the threads */
+    struct ArrayMergeTask *mergeTasks = (struct ArrayMergeTask *) xzalloc(parts + threads + 1, sizeof(struct ArrayMergeTask));
+    int32_t *src = values;
+    int32_t *dst = buffer;
+    size_t runs = parts;
+    while(runs > 1){
+        size_t taskCount = 0;
+        for(size_t r = 0; r < runs; r += 2){
+            const int32_t *left = src + bounds[r];
+            size_t leftCount = bounds[r + 1] - bounds[r];
+            const int32_t *right = src + bounds[r + 1];
+            size_t rightCount = (r + 1 < runs) ? bounds[r + 2] - bounds[r + 1] : 0;
+            size_t total = leftCount + rightCount;
+            size_t pieces = (total * threads + count - 1) / count;
+            if(pieces == 0) pieces = 1;
+            for(size_t q = 0; q < pieces; q++){
+                size_t d0 = (total * q) / pieces;
+                size_t d1 = (total * (q + 1)) / pieces;
+                size_t i0 = mergePathSplit(left, leftCount, right, rightCount, d0, compare);
+                size_t i1 = mergePathSplit(left, leftCount, right, rightCount, d1, compare);
+                struct ArrayMergeTask *task = &mergeTasks[taskCount++];
+                task->left = left + i0;
+                task->leftCount = i1 - i0;
+                task->right = right + (d0 - i0);
+                task->rightCount = (d1 - i1) - (d0 - i0);
+                task->dst = dst + bounds[r] + d0;
+                task->compare = compare;
+            }
+        }
+        runParallel(arrayMergeTask, mergeTasks, sizeof(struct ArrayMergeTask), taskCount, threads);
+
+        /* Keep the bounds of the merged runs */
+        size_t merged = 0;
+        for(size_t r = 0; r < runs; r += 2){
+            bounds[merged++] = bounds[r];
+        }
+        bounds[merged] = count;
+        runs = merged;
+
+        int32_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* An odd amount of merge levels leaves the result in the scratch buffer */
+    if(src != values){
+        memcpy(values, src, count * sizeof(int32_t));
+    }
+
+    free(mergeTasks);
+    free(sortTasks);
+    free(bounds);
+    arraySortScratchDestroy(ownScratch);
+}
+
+/*************************  Radix sort  ***************************/
+
+/* The chunks are counted and scattered with the steps of the serial radix sort,
+ * the sign bit is flipped so the negative values go first */
+#define RADIX_NAME int32
+#define RADIX_TYPE int32_t
+#define RADIX_KEY(x) (((uint32_t) (x)) ^ 0x80000000u)
+#include "radix_template.h"
+
+#define PARALLEL_RADIX_BUCKETS RADIX_TEMPLATE_BUCKETS
+#define PARALLEL_RADIX_PASSES (32 / RADIX_TEMPLATE_BITS)
+/* Values held by the write combining buffer of a bucket, a cache line */
+#define PARALLEL_RADIX_LINE 16
+
+struct RadixTask {
+    const int32_t *src;               /* Input of the pass */
+    int32_t *dst;                     /* Output of the pass, shared by all the tasks */
+    size_t begin;                     /* Chunk of src handled by this task */
+    size_t end;
+    int pass;                         /* Pass to be counted or scattered, -1 counts all of them */
+    size_t histograms[PARALLEL_RADIX_PASSES][PARALLEL_RADIX_BUCKETS]; /* Counts, then the offsets of the scatter */
+    int32_t lines[PARALLEL_RADIX_BUCKETS][PARALLEL_RADIX_LINE]; /* Write combining buffers, xzalloc does not align them to cache lines */
+};
+
+static void radixCountTask(void *arg){
+    struct RadixTask *task = (struct RadixTask *) arg;
+    int first = (task->pass < 0) ? 0 : task->pass;
+    int last = (task->pass < 0) ? PARALLEL_RADIX_PASSES - 1 : task->pass;
+    for(int pass = first; pass <= last; pass++){
+        memset(task->histograms[pass], 0, sizeof(task->histograms[pass]));
+    }
+    if(task->pass < 0){
+        /* The first read counts the digits of every pass at once */
+        int32RadixCount(task->src + task->begin, task->end - task->begin, task->histograms);
+    } else {
+        int32RadixCountPass(task->src + task->begin, task->end - task->begin, task->pass, task->histograms[task->pass]);
+    }
+}
+
+/**
+ * \brief Scatter the chunk to the offsets of its buckets. The values of every
+ * bucket are gathered in a cache line sized buffer and copied a line at a time,
+ * so the writes to the 256 destinations do not evict each other.
+ */
+static void radixScatterTask(void *arg){
+    struct RadixTask *task = (struct RadixTask *) arg;
+    size_t *offsets = task->histograms[task->pass];
+    uint8_t fill[PARALLEL_RADIX_BUCKETS] = {0};
+    for(size_t i = task->begin; i < task->end; i++){
+        int32_t value = task->src[i];
+        size_t bucket = int32RadixDigit(value, task->pass);
+        task->lines[bucket][fill[bucket]++] = value;
+        if(fill[bucket] == PARALLEL_RADIX_LINE){
+            memcpy(task->dst + offsets[bucket], task->lines[bucket], sizeof(task->lines[bucket]));
+            offsets[bucket] += PARALLEL_RADIX_LINE;
+            fill[bucket] = 0;
+        }
+    }
+    for(size_t bucket = 0; bucket < PARALLEL_RADIX_BUCKETS; bucket++){
+        memcpy(task->dst + offsets[bucket], task->lines[bucket], fill[bucket] * sizeof(int32_t));
+    }
+    SORT_STATS_ADD(nodeMoves, task->end - task->begin);
+}
+
+void integerArrayParallelRadixSort(int32_t *values, size_t count, size_t threads, size_t serialCutoff,
+                                   struct ArraySortScratch *scratch){
+    if(threads == 0) threads = parallelSortDefaultThreads();
+    size_t parts = parallelSortParts(count, threads, serialCutoff);
+    if(parts <= 1){
+        integerArrayRadixSort(values, count, scratch);
+        return;
+    }
+
+    struct ArraySortScratch *ownScratch = NULL;
+    if(scratch == NULL){
+        ownScratch = arraySortScratchCreate(count);
+        scratch = ownScratch;
+    }
+    int32_t *buffer = arraySortScratchReserve(scratch, count);
+
+    struct RadixTask *tasks = (struct RadixTask *) xzalloc(parts, sizeof(struct RadixTask));
+    for(size_t p = 0; p < parts; p++){
+        tasks[p].begin = (count / parts) * p + ((count % parts) * p) / parts;
+        tasks[p].end = (count / parts) * (p + 1) + ((count % parts) * (p + 1)) / parts;
+        tasks[p].src = values;
+        tasks[p].pass = -1;
+    }
+    runParallel(radixCountTask, tasks, sizeof(struct RadixTask), parts, threads);
+
+    int32_t *src = values;
+    int32_t *dst = buffer;
+    bool counted = true;  /* The histograms of the chunks match the order of src */
+    for(int pass = 0; pass < PARALLEL_RADIX_PASSES; pass++){
+        /* All the values share this digit, this pass would not change the order */
+        size_t total = 0;
+        size_t digit = int32RadixDigit(src[0], pass);
+        for(size_t p = 0; p < parts; p++) total += tasks[p].histograms[pass][digit];
+        if(total == count) continue;
+
+        if(!counted){
+            for(size_t p = 0; p < parts; p++){
+                tasks[p].src = src;
+                tasks[p].pass = pass;
+            }
+            runParallel(radixCountTask, tasks, sizeof(struct RadixTask), parts, threads);
+        }
+
+        /* Bucket by bucket, the chunks get consecutive offsets in order, so the sort is stable */
+        size_t offset = 0;
+        for(size_t bucket = 0; bucket < PARALLEL_RADIX_BUCKETS; bucket++){
+            for(size_t p = 0; p < parts; p++){
+                size_t bucketCount = tasks[p].histograms[pass][bucket];
+                tasks[p].histograms[pass][bucket] = offset;
+                offset += bucketCount;
+            }
+        }
+        for(size_t p = 0; p < parts; p++){
+            tasks[p].src = src;
+            tasks[p].dst = dst;
+            tasks[p].pass = pass;
+        }
+        SORT_STATS_ADD(mergePasses, 1);
+        runParallel(radixScatterTask, tasks, sizeof(struct RadixTask), parts, threads);
+        counted = false;
+
+        int32_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* An odd amount of passes leaves the result in the scratch buffer */
+    if(src != values){
+        memcpy(values, src, count * sizeof(int32_t));
+    }
+
+    free(tasks);
+    arraySortScratchDestroy(ownScratch);
+}
+
+enum ListReturnType integerListParallelRadixSort(struct List *list, size_t threads){
+    if(list == NULL) return RET_FAIL;
+    if(list->readOnly){
+        /* The values can not be written back, sort value and node pairs instead */
+        return integerListGatherSort(list, lessThan, GATHER_SORT_RELINK, NULL);
+    }
+    if(list->count > 1){
+        int32_t *values = (int32_t *) xzalloc(list->count, sizeof(int32_t));
+        size_t count = 0;
+        for(struct ListNode *node = list->head; node != NULL; node = node->next){
+            values[count++] = integerListNodeValue(node);
+        }
+        integerArrayParallelRadixSort(values, count, threads, PARALLEL_SORT_DEFAULT_CUTOFF, NULL);
+        count = 0;
+        for(struct ListNode *node = list->head; node != NULL; node = node->next){
+            *(int32_t *) node->value = values[count++];
+        }
+        SORT_STATS_ADD(nodeMoves, 2 * count);
+        free(values);
+    }
+    integerListMarkSorted(list, lessThan);
+    return RET_OK;
+}
@@ -0,0 +1,281 @@
+#include "partial_sort.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdlib.h>
+
+/* A candidate for the first k elements, index is its position in the list */
+struct HeapEntry {
+    struct ListNode *node;
+    int32_t value;
+    size_t index;
+};
+
+/* Bounded heap with the worst of the k best candidates on top */
+struct BoundedHeap {
+    struct HeapEntry *entries;
+    size_t count;
+    size_t capacity;
+    IntegerCompareFunction *compare;
+};
+
+/**
+ * \brief Tells if a goes after b in a stable sort, ties are broken by position
+ */
+static inline bool heapWorse(const struct BoundedHeap *heap, const struct HeapEntry *a, const struct HeapEntry *b){
+    if(SORT_COMPARE(heap->compare, b->value, a->value)) return true;
+    if(SORT_COMPARE(heap->compare, a->value, b->value)) return false;
+    return a->index > b->index;
+}
+
+static void heapSiftDown(struct BoundedHeap *heap, size_t i, size_t count){
+    struct HeapEntry entry = heap->entries[i];
+    for(;;){
+        size_t child = 2 * i + 1;
+        if(child >= count) break;
+        if((child + 1 < count) && heapWorse(heap, &heap->entries[child + 1], &heap->entries[child])) child++;
+        if(!heapWorse(heap, &heap->entries[child], &entry)) break;
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+    heap->entries[i] = entry;
+}
+
+static void heapSiftUp(struct BoundedHeap *heap, size_t i){
+    struct HeapEntry entry = heap->entries[i];
+    while(i > 0){
+        size_t parent = (i - 1) / 2;
+        if(!heapWorse(heap, &entry, &heap->entries[parent])) break;
+        heap->entries[i] = heap->entries[parent];
+        i = parent;
+    }
+    heap->entries[i] = entry;
+}
+
+/**
+ * \brief Scan the list keeping the best k nodes, then sort them in place so
+ * heap->entries holds them from the first to the last in the sorted order.
+ */
+static void heapSelect(struct BoundedHeap *heap, const struct List *list){
+    size_t index = 0;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next, index++){
+        struct HeapEntry entry = { .node = node, .value = integerListNodeValue(node), .index = index };
+        if(heap->count < heap->capacity){
+            heap->entries[heap->count] = entry;
+            heapSiftUp(heap, heap->count++);
+        } else if(SORT_COMPARE(heap->compare, entry.value, heap->entries[0].value)){
+            /* A later node only displaces the top when it is strictly better */
+            heap->entries[0] = entry;
+            heapSiftDown(heap, 0, heap->count);
+        }
+    }
+
+    /* Heap sort, the worst entries are moved to the end one by one */
+    for(size_t end = heap->count; end > 1; end--){
+        struct HeapEntry worst = heap->entries[0];
+        heap->entries[0] = heap->entries[end - 1];
+        heap->entries[end - 1] = worst;
+        heapSiftDown(heap, 0, end - 1);
+    }
+}
+
+enum ListReturnType integerListPartialSort(struct List *list, size_t k, IntegerCompareFunction compare){
+    if(list == NULL) return RET_FAIL;
+    if(k == 0) return RET_OK;
+    if(k >= list->count){
+        integerListMergeSortInPlace(list, compare);
+        return RET_OK;
+    }
+
+    struct BoundedHeap heap = {
+        .entries = (struct HeapEntry *) xzalloc(k, sizeof(struct HeapEntry)),
+        .count = 0,
+        .capacity = k,
+        .compare = compare
+    };
+    heapSelect(&heap, list);
+
+    /* Unlink the selected nodes, the others keep their relative order */
+    for(size_t i = 0; i < heap.count; i++){
+        struct ListNode *node = heap.entries[i].node;
+        if(node->prev != NULL) node->prev->next = node->next;
+        else list->head = node->next;
+        if(node->next != NULL) node->next->prev = node->prev;
+        else list->tail = node->prev;
+    }
+
+    /* Relink them in order in front of the rest of the list */
+    struct ListNode *next = list->head;
+    for(size_t i = heap.count; i > 0; i--){
+        struct ListNode *node = heap.entries[i - 1].node;
+        node->next = next;
+        node->prev = NULL;
+        if(next != NULL) next->prev = node;
+        else list->tail = node;
+        next = node;
+    }
+    list->head = next;
+    listMarkSorted(list, heap.count, (const void *) compare);
+    SORT_STATS_ADD(nodeMoves, heap.count);
+
+    free(heap.entries);
+    return RET_OK;
+}
+
+size_t integerListTopK(const struct List *list, size_t k, IntegerCompareFunction compare, int32_t *output){
+    if((list == NULL) || (output == NULL)) return 0;
+    if(k > list->count) k = list->count;
+    if(k == 0) return 0;
+
+    struct BoundedHeap heap = {
+        .entries = (struct HeapEntry *) xzalloc(k, sizeof(struct HeapEntry)),
+        .count = 0,
+        .capacity = k,
+        .compare = compare
+    };
+    heapSelect(&heap, list);
+    for(size_t i = 0; i < heap.count; i++){
+        output[i] = heap.entries[i].value;
+    }
+
+    free(heap.entries);
+    return k;
+}
+
+/* A run of linked nodes, NULL terminated through next and with valid prev links */
+struct NodeChain {
+    struct ListNode *head;
+    struct ListNode *tail;
+    size_t count;
+};
+
+static inline void chainAppend(struct NodeChain *chain, struct ListNode *node){
+    node->next = NULL;
+    node->prev = chain->tail;
+    if(chain->tail != NULL) chain->tail->next = node;
+    else chain->head = node;
+    chain->tail = node;
+    chain->count++;
+}
+
+static inline void chainConcat(struct NodeChain *chain, struct NodeChain other){
+    if(other.head == NULL) return;
+    if(chain->tail != NULL){
+        chain->tail->next = other.head;
+        other.head->prev = chain->tail;
+    } else {
+        chain->head = other.head;
+    }
+    chain->tail = other.tail;
+    chain->count += other.count;
+}
+
+/**
+ * \brief Small xorshift generator for the pivot positions. A fixed seed keeps
+ * the selection reproducible, while the positions still look random to the input.
+ */
+static inline uint64_t selectRandom(uint64_t *state){
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+enum ListReturnType integerListSelect(struct List *list, size_t k, IntegerCompareFunction compare, int32_t *result){
+    if((list == NULL) || (k >= list->count)) return RET_FAIL;
+
+    uint64_t state = 0x9E3779B97F4A7C15ull ^ list->count;
+    struct NodeChain prefix = {0};
+    struct NodeChain suffix = {0};
+    struct NodeChain current = { .head = list->head, .tail = list->tail, .count = list->count };
+    for(;;){
+        struct ListNode *pivotNode = current.head;
+        for(size_t i = selectRandom(&state) % current.count; i > 0; i--){
+            pivotNode = pivotNode->next;
+        }
+        int32_t pivot = integerListNodeValue(pivotNode);
+
+        struct NodeChain before = {0};
+        struct NodeChain equal = {0};
+        struct NodeChain after = {0};
+        struct ListNode *node = current.head;
+        while(node != NULL){
+            struct ListNode *next = node->next;
+            int32_t value = integerListNodeValue(node);
+            if(SORT_COMPARE(compare, value, pivot)) chainAppend(&before, node);
+            else if(SORT_COMPARE(compare, pivot, value)) chainAppend(&after, node);
+            else chainAppend(&equal, node);
+            node = next;
+        }
+        SORT_STATS_ADD(nodeMoves, current.count);
+
+        if(k < before.count){
+            chainConcat(&equal, after);
+            chainConcat(&equal, suffix);
+            suffix = equal;
+            current = before;
+        } else if(k < before.count + equal.count){
+            chainConcat(&prefix, before);
+            chainConcat(&prefix, equal);
+            chainConcat(&prefix, after);
+            chainConcat(&prefix, suffix);
+            if(result != NULL) *result = pivot;
+            break;
+        } else {
+            k -= before.count + equal.count;
+            chainConcat(&prefix, before);
+            chainConcat(&prefix, equal);
+            current = after;
+        }
+    }
+
+    list->head = prefix.head;
+    list->tail = prefix.tail;
+    list->sortedCount = 0;
+    return RET_OK;
+}
+
+static inline void swapValues(int32_t *a, int32_t *b){
+    int32_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+enum ListReturnType integerArraySelect(int32_t *values, size_t count, size_t k, IntegerCompareFunction compare, int32_t *result){
+    if((values == NULL) || (k >= count)) return RET_FAIL;
+
+    uint64_t state = 0x9E3779B97F4A7C15ull ^ count;
+    size_t lo = 0;
+    size_t hi = count;  /* Exclusive end of the range holding position k */
+    for(;;){
+        int32_t pivot = values[lo + selectRandom(&state) % (hi - lo)];
+
+        /* Three way partition: [lo, lt) before, [lt, gt) equal, [gt, hi) after the pivot */
+        size_t lt = lo;
+        size_t gt = hi;
+        size_t i = lo;
+        while(i < gt){
+            if(SORT_COMPARE(compare, values[i], pivot)){
+                swapValues(&values[lt++], &values[i++]);
+            } else if(SORT_COMPARE(compare, pivot, values[i])){
+                swapValues(&values[i], &values[--gt]);
+            } else {
+                i++;
+            }
+        }
+        SORT_STATS_ADD(nodeMoves, hi - lo);
+
+        if(k < lt){
+            hi = lt;
+        } else if(k >= gt){
+            lo = gt;
+        } else {
+            break;
+        }
+    }
+
+    if(result != NULL) *result = values[k];
+    return RET_OK;
+}
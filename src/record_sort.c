@@ -0,0 +1,142 @@
+#include "record_sort.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RECORD_SIGN_BIT 0x8000000000000000ull
+
+/* A numeric key encoded as an unsigned integer and the node holding it */
+struct RecordPair {
+    uint64_t key;
+    struct ListNode *node;
+};
+
+/* A byte string key and the node holding it */
+struct RecordBytesPair {
+    const uint8_t *bytes;
+    size_t size;
+    struct ListNode *node;
+};
+
+static inline bool recordBytesLess(const struct RecordBytesPair *a, const struct RecordBytesPair *b){
+    size_t size = (a->size < b->size) ? a->size : b->size;
+    int order = (size > 0) ? memcmp(a->bytes, b->bytes, size) : 0;
+    return (order < 0) || ((order == 0) && (a->size < b->size));
+}
+
+#define SORT_NAME recordPair
+#define SORT_TYPE struct RecordPair
+#define SORT_KEY(x) ((x).key)
+#include "sort_template.h"
+
+#define SORT_NAME recordBytesPair
+#define SORT_TYPE struct RecordBytesPair
+#define SORT_LESS(a, b) recordBytesLess(&(a), &(b))
+#include "sort_template.h"
+
+/**
+ * \brief Encode a numeric key as an unsigned integer with the same order.
+ * The sign bit of signed integers is flipped. Doubles flip all their bits when
+ * negative and only the sign bit otherwise, which gives the IEEE 754 total order.
+ */
+static inline uint64_t recordKeyEncode(enum RecordKeyType type, const struct RecordKey *key){
+    switch(type){
+        case RECORD_KEY_INT64:
+            return ((uint64_t) key->int64) ^ RECORD_SIGN_BIT;
+        case RECORD_KEY_DOUBLE: {
+            uint64_t bits;
+            memcpy(&bits, &key->real, sizeof(bits));
+            return (bits & RECORD_SIGN_BIT) ? ~bits : (bits | RECORD_SIGN_BIT);
+        }
+        default:
+            return key->uint64;
+    }
+}
+
+/* Radix sort of the pairs by their encoded keys */
+#define RADIX_NAME recordPair
+#define RADIX_TYPE struct RecordPair
+#define RADIX_KEY(x) ((x).key)
+#define RADIX_KEY_BITS 64
+#include "radix_template.h"
+
+/**
+ * \brief Link node after last, returns node as the new last one
+ */
+static inline struct ListNode *recordLink(struct List *list, struct ListNode *last, struct ListNode *node){
+    node->prev = last;
+    if(last != NULL){
+        last->next = node;
+    } else {
+        list->head = node;
+    }
+    return node;
+}
+
+static void recordSortNumbers(struct List *list, enum RecordKeyType type, RecordKeyFunction *keyFunction){
+    struct RecordPair *pairs = (struct RecordPair *) xzalloc(2 * list->count, sizeof(struct RecordPair));
+    struct RecordPair *buffer = pairs + list->count;
+    size_t count = 0;
+    struct RecordKey key;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        memset(&key, 0, sizeof(key));
+        keyFunction(node->value, &key);
+        pairs[count].key = recordKeyEncode(type, &key);
+        pairs[count].node = node;
+        count++;
+    }
+    SORT_STATS_ADD(nodeMoves, count);
+
+    struct RecordPair *sorted = pairs;
+    if(count >= RECORD_SORT_RADIX_MIN_SIZE){
+        sorted = recordPairRadixSort(pairs, buffer, count);
+    } else {
+        recordPairSort(pairs, count, buffer);
+    }
+
+    struct ListNode *last = NULL;
+    for(size_t i = 0; i < count; i++) last = recordLink(list, last, sorted[i].node);
+    last->next = NULL;
+    list->tail = last;
+    free(pairs);
+}
+
+static void recordSortBytes(struct List *list, RecordKeyFunction *keyFunction){
+    struct RecordBytesPair *pairs = (struct RecordBytesPair *) xzalloc(2 * list->count, sizeof(struct RecordBytesPair));
+    struct RecordBytesPair *buffer = pairs + list->count;
+    size_t count = 0;
+    struct RecordKey key;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        memset(&key, 0, sizeof(key));
+        keyFunction(node->value, &key);
+        pairs[count].bytes = (const uint8_t *) key.bytes;
+        pairs[count].size = key.size;
+        pairs[count].node = node;
+        count++;
+    }
+    SORT_STATS_ADD(nodeMoves, count);
+
+    recordBytesPairSort(pairs, count, buffer);
+
+    struct ListNode *last = NULL;
+    for(size_t i = 0; i < count; i++) last = recordLink(list, last, pairs[i].node);
+    last->next = NULL;
+    list->tail = last;
+    free(pairs);
+}
+
+enum ListReturnType listRecordSort(struct List *list, enum RecordKeyType type, RecordKeyFunction *key){
+    if((list == NULL) || (key == NULL)) return RET_FAIL;
+    /* The keys can change inside the records without the list knowing it, so the list is always sorted */
+    if(list->count > 1){
+        if(type == RECORD_KEY_BYTES){
+            recordSortBytes(list, key);
+        } else {
+            recordSortNumbers(list, type, key);
+        }
+    }
+    listMarkSorted(list, list->count, (const void *) key);
+    return RET_OK;
+}
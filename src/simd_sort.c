@@ -0,0 +1,309 @@
+#include "simd_sort.h"
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_SORT_X86
+#include <immintrin.h>
+#endif
+
+/* Blocks are padded with the largest value, which is sorted to the end */
+#define SIMD_SORT_PADDING INT32_MAX
+
+typedef void (*BlockSortFunction)(int32_t *block, size_t count);
+
+static void scalarSortBlock(int32_t *values, size_t count){
+    for(size_t i = 1; i < count; i++){
+        int32_t value = values[i];
+        size_t j = i;
+        while((j > 0) && (values[j - 1] > value)){
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+/**
+ * \brief Smallest network size able to hold count values
+ */
+static inline size_t networkSize(size_t count, size_t lanes){
+    if(count <= lanes) return lanes;
+    if(count <= 2 * lanes) return 2 * lanes;
+    if(count <= 16) return 16;
+    return SIMD_SORT_BLOCK_SIZE;
+}
+
+#ifdef SIMD_SORT_X86
+
+/*
+ * Both kernels follow the same plan: every register is sorted with an in
+ * register bitonic network (shuffle, min, max, blend), then pairs of sorted
+ * sequences are merged with bitonic merges, doubling their size until the
+ * whole block is sorted. The blend masks select the lanes that keep the
+ * maximum of every compare-exchange.
+ */
+
+__attribute__((target("sse4.1")))
+static inline __m128i sse41Exchange1(__m128i v, int mask){
+    __m128i p = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128i lo = _mm_min_epi32(v, p);
+    __m128i hi = _mm_max_epi32(v, p);
+    switch(mask){
+        case 0x3C: return _mm_blend_epi16(lo, hi, 0x3C);
+        default:   return _mm_blend_epi16(lo, hi, 0xCC);
+    }
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i sse41Exchange2(__m128i v){
+    __m128i p = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm_blend_epi16(_mm_min_epi32(v, p), _mm_max_epi32(v, p), 0xF0);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i sse41Sort(__m128i v){
+    v = sse41Exchange1(v, 0x3C);
+    v = sse41Exchange2(v);
+    return sse41Exchange1(v, 0xCC);
+}
+
+/**
+ * \brief Sorts a bitonic register
+ */
+__attribute__((target("sse4.1")))
+static inline __m128i sse41Clean(__m128i v){
+    v = sse41Exchange2(v);
+    return sse41Exchange1(v, 0xCC);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i sse41Reverse(__m128i v){
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/**
+ * \brief Merges the sorted sequences of width registers at regs and regs + width
+ */
+__attribute__((target("sse4.1")))
+static void sse41Merge(__m128i *regs, size_t width){
+    for(size_t i = 0; i < width / 2; i++){
+        __m128i tmp = regs[width + i];
+        regs[width + i] = sse41Reverse(regs[2 * width - 1 - i]);
+        regs[2 * width - 1 - i] = sse41Reverse(tmp);
+    }
+    if(width % 2 == 1){
+        regs[width + width / 2] = sse41Reverse(regs[width + width / 2]);
+    }
+    for(size_t stride = width; stride > 0; stride /= 2){
+        for(size_t i = 0; i < 2 * width; i++){
+            if((i & stride) != 0) continue;
+            __m128i lo = _mm_min_epi32(regs[i], regs[i + stride]);
+            regs[i + stride] = _mm_max_epi32(regs[i], regs[i + stride]);
+            regs[i] = lo;
+        }
+    }
+    for(size_t i = 0; i < 2 * width; i++){
+        regs[i] = sse41Clean(regs[i]);
+    }
+}
+
+__attribute__((target("sse4.1")))
+static void sse41SortBlock(int32_t *block, size_t count){
+    __m128i regs[SIMD_SORT_BLOCK_SIZE / 4];
+    size_t size = networkSize(count, 4);
+    size_t regCount = size / 4;
+    for(size_t i = 0; i < regCount; i++){
+        regs[i] = sse41Sort(_mm_loadu_si128((const __m128i *) (block + 4 * i)));
+    }
+    for(size_t width = 1; width < regCount; width *= 2){
+        for(size_t i = 0; i < regCount; i += 2 * width){
+            sse41Merge(regs + i, width);
+        }
+    }
+    for(size_t i = 0; i < regCount; i++){
+        _mm_storeu_si128((__m128i *) (block + 4 * i), regs[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2Exchange(__m256i v, __m256i permutation, int mask){
+    __m256i p = _mm256_permutevar8x32_epi32(v, permutation);
+    __m256i lo = _mm256_min_epi32(v, p);
+    __m256i hi = _mm256_max_epi32(v, p);
+    /* The blend mask has to be an immediate */
+    switch(mask){
+        case 0x66: return _mm256_blend_epi32(lo, hi, 0x66);
+        case 0x3C: return _mm256_blend_epi32(lo, hi, 0x3C);
+        case 0x5A: return _mm256_blend_epi32(lo, hi, 0x5A);
+        case 0xF0: return _mm256_blend_epi32(lo, hi, 0xF0);
+        case 0xCC: return _mm256_blend_epi32(lo, hi, 0xCC);
+        default:   return _mm256_blend_epi32(lo, hi, 0xAA);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2Sort(__m256i v){
+    const __m256i stride1 = _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6);
+    const __m256i stride2 = _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5);
+    const __m256i stride4 = _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3);
+    v = avx2Exchange(v, stride1, 0x66);
+    v = avx2Exchange(v, stride2, 0x3C);
+    v = avx2Exchange(v, stride1, 0x5A);
+    v = avx2Exchange(v, stride4, 0xF0);
+    v = avx2Exchange(v, stride2, 0xCC);
+    return avx2Exchange(v, stride1, 0xAA);
+}
+
+/**
+ * \brief Sorts a bitonic register
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2Clean(__m256i v){
+    const __m256i stride1 = _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6);
+    const __m256i stride2 = _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5);
+    const __m256i stride4 = _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3);
+    v = avx2Exchange(v, stride4, 0xF0);
+    v = avx2Exchange(v, stride2, 0xCC);
+    return avx2Exchange(v, stride1, 0xAA);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2Reverse(__m256i v){
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+/**
+ * \brief Merges the sorted sequences of width registers at regs and regs + width
+ */
+__attribute__((target("avx2")))
+static void avx2Merge(__m256i *regs, size_t width){
+    for(size_t i = 0; i < width / 2; i++){
+        __m256i tmp = regs[width + i];
+        regs[width + i] = avx2Reverse(regs[2 * width - 1 - i]);
+        regs[2 * width - 1 - i] = avx2Reverse(tmp);
+    }
+    if(width % 2 == 1){
+        regs[width + width / 2] = avx2Reverse(regs[width + width / 2]);
+    }
+    for(size_t stride = width; stride > 0; stride /= 2){
+        for(size_t i = 0; i < 2 * width; i++){
+            if((i & stride) != 0) continue;
+            __m256i lo = _mm256_min_epi32(regs[i], regs[i + stride]);
+            regs[i + stride] = _mm256_max_epi32(regs[i], regs[i + stride]);
+            regs[i] = lo;
+        }
+    }
+    for(size_t i = 0; i < 2 * width; i++){
+        regs[i] = avx2Clean(regs[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+static void avx2SortBlock(int32_t *block, size_t count){
+    __m256i regs[SIMD_SORT_BLOCK_SIZE / 8];
+    size_t size = networkSize(count, 8);
+    size_t regCount = size / 8;
+    for(size_t i = 0; i < regCount; i++){
+        regs[i] = avx2Sort(_mm256_loadu_si256((const __m256i *) (block + 8 * i)));
+    }
+    for(size_t width = 1; width < regCount; width *= 2){
+        for(size_t i = 0; i < regCount; i += 2 * width){
+            avx2Merge(regs + i, width);
+        }
+    }
+    for(size_t i = 0; i < regCount; i++){
+        _mm256_storeu_si256((__m256i *) (block + 8 * i), regs[i]);
+    }
+}
+
+#endif //SIMD_SORT_X86
+
+/* The best kernel is selected once, simdSortSetKernel can replace it later from any thread */
+static pthread_once_t kernelOnce = PTHREAD_ONCE_INIT;
+static enum SimdSortKernel selectedKernel = SIMD_SORT_SCALAR;
+
+bool simdSortKernelSupported(enum SimdSortKernel kernel){
+    switch(kernel){
+        case SIMD_SORT_SCALAR:
+            return true;
+#ifdef SIMD_SORT_X86
+        case SIMD_SORT_SSE41:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.1");
+        case SIMD_SORT_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+static void simdSortSelectKernel(void){
+    enum SimdSortKernel kernel = SIMD_SORT_SCALAR;
+    if(simdSortKernelSupported(SIMD_SORT_AVX2)){
+        kernel = SIMD_SORT_AVX2;
+    } else if(simdSortKernelSupported(SIMD_SORT_SSE41)){
+        kernel = SIMD_SORT_SSE41;
+    }
+    __atomic_store_n(&selectedKernel, kernel, __ATOMIC_RELAXED);
+}
+
+enum SimdSortKernel simdSortKernel(void){
+    pthread_once(&kernelOnce, simdSortSelectKernel);
+    return __atomic_load_n(&selectedKernel, __ATOMIC_RELAXED);
+}
+
+bool simdSortSetKernel(enum SimdSortKernel kernel){
+    if(!simdSortKernelSupported(kernel)) return false;
+    /* Select the best kernel first, so it does not replace this one later */
+    pthread_once(&kernelOnce, simdSortSelectKernel);
+    __atomic_store_n(&selectedKernel, kernel, __ATOMIC_RELAXED);
+    return true;
+}
+
+const char *simdSortKernelName(enum SimdSortKernel kernel){
+    switch(kernel){
+        case SIMD_SORT_SCALAR: return "scalar";
+        case SIMD_SORT_SSE41:  return "sse4.1";
+        case SIMD_SORT_AVX2:   return "avx2";
+        default:               return "unknown";
+    }
+}
+
+void int32SortBlock(int32_t *values, size_t count){
+    if(count < 2) return;
+    BlockSortFunction sortBlock = scalarSortBlock;
+    size_t lanes = 1;
+#ifdef SIMD_SORT_X86
+    switch(simdSortKernel()){
+        case SIMD_SORT_AVX2:
+            sortBlock = avx2SortBlock;
+            lanes = 8;
+            break;
+        case SIMD_SORT_SSE41:
+            sortBlock = sse41SortBlock;
+            lanes = 4;
+            break;
+        default:
+            break;
+    }
+#endif
+    if(lanes == 1){
+        sortBlock(values, count);
+        return;
+    }
+    size_t size = networkSize(count, lanes);
+    if(size == count){
+        sortBlock(values, count);
+        return;
+    }
+    int32_t block[SIMD_SORT_BLOCK_SIZE];
+    memcpy(block, values, count * sizeof(int32_t));
+    for(size_t i = count; i < size; i++){
+        block[i] = SIMD_SORT_PADDING;
+    }
+    sortBlock(block, count);
+    memcpy(values, block, count * sizeof(int32_t));
+}
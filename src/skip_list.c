@@ -0,0 +1,163 @@
+#include "skip_list.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdlib.h>
+
+/* A node of the list with its tower of forward links */
+struct SkipListEntry {
+    struct ListNode *node;              /* Node of the list, NULL for the sentinel */
+    int32_t value;                      /* Copy of the value to avoid touching the node */
+    size_t height;                      /* Amount of forward links */
+    struct SkipListEntry *forward[];
+};
+
+static struct SkipListEntry *skipListEntryCreate(struct ListNode *node, int32_t value, size_t height){
+    struct SkipListEntry *entry = (struct SkipListEntry *) xzalloc(1, sizeof(struct SkipListEntry) +
+                                                                      height * sizeof(struct SkipListEntry *));
+    entry->node = node;
+    entry->value = value;
+    entry->height = height;
+    return entry;
+}
+
+/**
+ * \brief Height of a new tower, every level is reached with probability 1/4
+ */
+static size_t skipListRandomHeight(struct SkipListIndex *index){
+    uint64_t x = index->random;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    index->random = x;
+    size_t height = 1;
+    while((height < SKIP_LIST_MAX_LEVEL) && ((x & 3) == 0)){
+        height++;
+        x >>= 2;
+    }
+    return height;
+}
+
+/**
+ * \brief Find the last entry of every level accepted by the search.
+ * When strict is set the accepted entries are placed strictly before value,
+ * otherwise entries equal to value are accepted as well.
+ */
+static void skipListFindPrevious(const struct SkipListIndex *index, int32_t value, bool strict,
+                                 struct SkipListEntry **update){
+    struct SkipListEntry *entry = index->head;
+    for(size_t level = index->level; level > 0; level--){
+        struct SkipListEntry *next = entry->forward[level - 1];
+        while((next != NULL) && (strict ? SORT_COMPARE(index->compare, next->value, value)
+                                        : !SORT_COMPARE(index->compare, value, next->value))){
+            entry = next;
+            next = entry->forward[level - 1];
+        }
+        update[level - 1] = entry;
+    }
+}
+
+struct SkipListIndex *skipListIndexCreate(struct List *list, IntegerCompareFunction compare){
+    if(list == NULL) return NULL;
+    if(integerListSortedPrefix(list, compare) < list->count){
+        integerListMergeSortInPlace(list, compare);
+        integerListMarkSorted(list, compare);
+    }
+
+    struct SkipListIndex *index = (struct SkipListIndex *) xzalloc(1, sizeof(struct SkipListIndex));
+    index->list = list;
+    index->compare = compare;
+    index->head = skipListEntryCreate(NULL, 0, SKIP_LIST_MAX_LEVEL);
+    index->level = 1;
+    index->random = 0x9E3779B97F4A7C15ull;
+
+    /* The list is sorted, so every tower is appended after the last one of its levels O(n) */
+    struct SkipListEntry *last[SKIP_LIST_MAX_LEVEL];
+    for(size_t level = 0; level < SKIP_LIST_MAX_LEVEL; level++) last[level] = index->head;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        size_t height = skipListRandomHeight(index);
+        struct SkipListEntry *entry = skipListEntryCreate(node, integerListNodeValue(node), height);
+        for(size_t level = 0; level < height; level++){
+            last[level]->forward[level] = entry;
+            last[level] = entry;
+        }
+        if(height > index->level) index->level = height;
+    }
+    return index;
+}
+
+void skipListIndexDestroy(struct SkipListIndex *index){
+    if(index == NULL) return;
+    struct SkipListEntry *entry = index->head;
+    while(entry != NULL){
+        struct SkipListEntry *next = entry->forward[0];
+        free(entry);
+        entry = next;
+    }
+    free(index);
+}
+
+struct ListNode *skipListIndexInsert(struct SkipListIndex *index, int32_t value){
+    if(index == NULL) return NULL;
+    struct SkipListEntry *update[SKIP_LIST_MAX_LEVEL];
+    skipListFindPrevious(index, value, false, update);
+
+    struct List *list = index->list;
+    struct ListNode *node = integerListNodeCreateFor(list, value);
+    if(node == NULL) return NULL;
+    struct SkipListEntry *previous = update[0];
+    if(previous == index->head){
+        listAppendStart(list, node);
+    } else {
+        listInsertAfter(list, previous->node, node);
+    }
+    /* The insertion resets the sorted prefix, but the index keeps the list sorted */
+    integerListMarkSorted(list, index->compare);
+
+    size_t height = skipListRandomHeight(index);
+    while(index->level < height){
+        update[index->level] = index->head;
+        index->level++;
+    }
+    struct SkipListEntry *entry = skipListEntryCreate(node, value, height);
+    for(size_t level = 0; level < height; level++){
+        entry->forward[level] = update[level]->forward[level];
+        update[level]->forward[level] = entry;
+    }
+    return node;
+}
+
+struct ListNode *skipListIndexLowerBound(const struct SkipListIndex *index, int32_t value){
+    if(index == NULL) return NULL;
+    struct SkipListEntry *update[SKIP_LIST_MAX_LEVEL];
+    skipListFindPrevious(index, value, true, update);
+    struct SkipListEntry *entry = update[0]->forward[0];
+    return (entry != NULL) ? entry->node : NULL;
+}
+
+struct ListNode *skipListIndexFind(const struct SkipListIndex *index, int32_t value){
+    struct ListNode *node = skipListIndexLowerBound(index, value);
+    if((node == NULL) || SORT_COMPARE(index->compare, value, integerListNodeValue(node))) return NULL;
+    return node;
+}
+
+enum ListReturnType skipListIndexRemove(struct SkipListIndex *index, int32_t value){
+    if(index == NULL) return RET_FAIL;
+    struct SkipListEntry *update[SKIP_LIST_MAX_LEVEL];
+    skipListFindPrevious(index, value, true, update);
+    struct SkipListEntry *entry = update[0]->forward[0];
+    if((entry == NULL) || SORT_COMPARE(index->compare, value, entry->value)) return RET_FAIL;
+
+    for(size_t level = 0; level < entry->height; level++){
+        update[level]->forward[level] = entry->forward[level];
+    }
+    while((index->level > 1) && (index->head->forward[index->level - 1] == NULL)){
+        index->level--;
+    }
+
+    listRemove(index->list, entry->node);
+    listNodeFree(index->list, entry->node);
+    integerListMarkSorted(index->list, index->compare);
+    free(entry);
+    return RET_OK;
+}
@@ -0,0 +1,56 @@
+#include "sort_stats.h"
+#include <string.h>
+#include <time.h>
+
+#ifdef MERGESORT_STATS
+
+_Thread_local struct SortStats sortStatsCurrent;
+
+uint64_t sortStatsNowNs(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+bool sortStatsEnabled(void){
+    return true;
+}
+
+void sortStatsReset(void){
+    memset(&sortStatsCurrent, 0, sizeof(sortStatsCurrent));
+}
+
+void sortStatsGet(struct SortStats *stats){
+    *stats = sortStatsCurrent;
+}
+
+void sortStatsAccumulate(const struct SortStats *stats){
+    sortStatsCurrent.comparisons += stats->comparisons;
+    sortStatsCurrent.nodeMoves += stats->nodeMoves;
+    sortStatsCurrent.merges += stats->merges;
+    sortStatsCurrent.mergePasses += stats->mergePasses;
+    sortStatsCurrent.allocations += stats->allocations;
+    sortStatsCurrent.allocatedBytes += stats->allocatedBytes;
+    sortStatsCurrent.splitNs += stats->splitNs;
+    sortStatsCurrent.mergeNs += stats->mergeNs;
+    sortStatsCurrent.copyBackNs += stats->copyBackNs;
+}
+
+#else
+
+bool sortStatsEnabled(void){
+    return false;
+}
+
+void sortStatsReset(void){
+}
+
+void sortStatsGet(struct SortStats *stats){
+    memset(stats, 0, sizeof(*stats));
+}
+
+void sortStatsAccumulate(const struct SortStats *stats){
+    (void) stats;
+}
+
+#endif //MERGESORT_STATS
@@ -0,0 +1,252 @@
+#include "sorted_set.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include <stdlib.h>
+
+/* Consecutive stretches won by the same list before looking for the end of the stretch with a gallop */
+#define SORTED_SET_MIN_GALLOP MERGE_SORT_DEFAULT_MIN_GALLOP
+
+/* What is kept by an operation, the nodes of other matching a node of list are always freed */
+struct SortedSetRule {
+    bool keepOnlyList;  /* Nodes of list without a match */
+    bool keepOnlyOther; /* Nodes of other without a match */
+    bool keepMatched;   /* Nodes of list with a match */
+};
+
+static const struct SortedSetRule unionRule = { .keepOnlyList = true, .keepOnlyOther = true, .keepMatched = true };
+static const struct SortedSetRule intersectionRule = { .keepOnlyList = false, .keepOnlyOther = false, .keepMatched = true };
+static const struct SortedSetRule differenceRule = { .keepOnlyList = true, .keepOnlyOther = false, .keepMatched = false };
+
+/**
+ * \brief Sort the list unless its recorded sorted prefix covers it and is still
+ * sorted. The natural merge sort takes O(n) on lists that are already sorted
+ * but were not marked.
+ */
+static void sortedSetPrepare(struct List *list, IntegerCompareFunction compare){
+    if(integerListSortedPrefix(list, compare) < list->count){
+        integerListNaturalMergeSort(list, compare);
+    }
+}
+
+/**
+ * \brief Free the nodes from first to last of a list, their links are not fixed.
+ * \return The amount of nodes freed
+ */
+static size_t sortedSetFreeSegment(struct List *owner, struct ListNode *first, struct ListNode *last){
+    size_t count = 0;
+    struct ListNode *node = first;
+    for(;;){
+        struct ListNode *next = node->next;
+        bool end = (node == last);
+        listNodeFree(owner, node);
+        count++;
+        if(end) return count;
+        node = next;
+    }
+}
+
+/**
+ * \brief Find the end of the stretch starting at node that goes before key.
+ * The first node is known to go before key, the next ones are only searched
+ * with a gallop once the same list won SORTED_SET_MIN_GALLOP times in a row.
+ */
+static struct ListNode *sortedSetStretch(struct ListNode *node, int32_t key, IntegerCompareFunction compare,
+                                         size_t *wins){
+    if((++*wins < SORTED_SET_MIN_GALLOP) || (node->next == NULL)) return node;
+    *wins = 0;
+    struct ListNode *end = integerListGallop(node->next, key, compare, true);
+    return (end != NULL) ? end : node;
+}
+
+/**
+ * \brief Append the segment first..last to the result ending at tail.
+ * The segment is spliced at once if its nodes can be linked into list, otherwise
+ * its values are copied into new nodes of list and the nodes of owner are freed.
+ * \return The new tail of the result
+ */
+static struct ListNode *sortedSetAppend(struct List *list, struct List *owner, struct ListNode *tail,
+                                        struct ListNode *first, struct ListNode *last){
+    if(listCanMoveNodes(list, owner)){
+        /* Splice the segment first..last, its inner links are already right */
+        SORT_STATS_ADD(nodeMoves, 1);
+        tail->next = first;
+        first->prev = tail;
+        return last;
+    }
+    struct ListNode *node = first;
+    for(;;){
+        struct ListNode *next = node->next;
+        bool end = (node == last);
+        struct ListNode *copy = integerListNodeCreateFor(list, integerListNodeValue(node));
+        SORT_STATS_ADD(nodeMoves, 1);
+        tail->next = copy;
+        copy->prev = tail;
+        tail = copy;
+        listNodeFree(owner, node);
+        if(end) return tail;
+        node = next;
+    }
+}
+
+/**
+ * \brief Walk both lists once, linking the segments kept by the rule into the
+ * result and freeing the rest. The result is left in list and other is emptied.
+ */
+static void sortedSetCombine(struct List *list, struct List *other, IntegerCompareFunction compare,
+                             const struct SortedSetRule *rule){
+    sortedSetPrepare(list, compare);
+    sortedSetPrepare(other, compare);
+
+    struct ListNode dummy = {0};
+    struct ListNode *tail = &dummy;
+    struct ListNode *nodeA = list->head;
+    struct ListNode *nodeB = other->head;
+    size_t count = list->count + other->count;
+    size_t winsA = 0;
+    size_t winsB = 0;
+    while((nodeA != NULL) && (nodeB != NULL)){
+        int32_t valueA = integerListNodeValue(nodeA);
+        int32_t valueB = integerListNodeValue(nodeB);
+        struct ListNode *first;
+        struct ListNode *last;
+        struct List *owner;
+        bool keep;
+        if(SORT_COMPARE(compare, valueA, valueB)){
+            winsB = 0;
+            first = nodeA;
+            last = sortedSetStretch(nodeA, valueB, compare, &winsA);
+            nodeA = last->next;
+            owner = list;
+            keep = rule->keepOnlyList;
+        } else if(SORT_COMPARE(compare, valueB, valueA)){
+            winsA = 0;
+            first = nodeB;
+            last = sortedSetStretch(nodeB, valueA, compare, &winsB);
+            nodeB = last->next;
+            owner = other;
+            keep = rule->keepOnlyOther;
+        } else {
+            /* A match, the node of other is always dropped */
+            winsA = 0;
+            winsB = 0;
+            struct ListNode *matched = nodeB;
+            nodeB = nodeB->next;
+            count -= sortedSetFreeSegment(other, matched, matched);
+            first = nodeA;
+            last = nodeA;
+            nodeA = nodeA->next;
+            owner = list;
+            keep = rule->keepMatched;
+        }
+        if(keep){
+            tail = sortedSetAppend(list, owner, tail, first, last);
+        } else {
+            count -= sortedSetFreeSegment(owner, first, last);
+        }
+    }
+
+    /* One of the lists is exhausted, the rest of the other one ends at its old tail */
+    if(nodeA != NULL){
+        if(rule->keepOnlyList){
+            tail = sortedSetAppend(list, list, tail, nodeA, list->tail);
+        } else {
+            count -= sortedSetFreeSegment(list, nodeA, list->tail);
+        }
+    } else if(nodeB != NULL){
+        if(rule->keepOnlyOther){
+            tail = sortedSetAppend(list, other, tail, nodeB, other->tail);
+        } else {
+            count -= sortedSetFreeSegment(other, nodeB, other->tail);
+        }
+    }
+
+    tail->next = NULL;
+    list->head = dummy.next;
+    list->tail = (list->head != NULL) ? tail : NULL;
+    if(list->head != NULL) list->head->prev = NULL;
+    list->count = count;
+    other->head = NULL;
+    other->tail = NULL;
+    other->count = 0;
+    integerListMarkSorted(list, compare);
+    integerListMarkSorted(other, compare);
+}
+
+enum ListReturnType integerListUnique(struct List *list, IntegerCompareFunction compare){
+    if(list == NULL) return RET_FAIL;
+    sortedSetPrepare(list, compare);
+    for(struct ListNode *node = list->head; (node != NULL) && (node->next != NULL); node = node->next){
+        /* The nodes after node that are not placed after it are equal to it */
+        struct ListNode *end = integerListGallop(node->next, integerListNodeValue(node), compare, false);
+        if(end == NULL) continue;
+        struct ListNode *after = end->next;
+        list->count -= sortedSetFreeSegment(list, node->next, end);
+        node->next = after;
+        if(after != NULL){
+            after->prev = node;
+        } else {
+            list->tail = node;
+        }
+    }
+    integerListMarkSorted(list, compare);
+    return RET_OK;
+}
+
+enum ListReturnType integerListUnion(struct List *list, struct List *other, IntegerCompareFunction compare){
+    if((list == NULL) || (other == NULL) || (list == other)) return RET_FAIL;
+    /* The values of other would have to be copied into new nodes, which a readOnly list can not create */
+    if(list->readOnly && !listCanMoveNodes(list, other) && (other->count > 0)) return RET_FAIL;
+    sortedSetCombine(list, other, compare, &unionRule);
+    return RET_OK;
+}
+
+enum ListReturnType integerListIntersection(struct List *list, struct List *other, IntegerCompareFunction compare){
+    if((list == NULL) || (other == NULL) || (list == other)) return RET_FAIL;
+    sortedSetCombine(list, other, compare, &intersectionRule);
+    return RET_OK;
+}
+
+enum ListReturnType integerListDifference(struct List *list, struct List *other, IntegerCompareFunction compare){
+    if((list == NULL) || (other == NULL) || (list == other)) return RET_FAIL;
+    sortedSetCombine(list, other, compare, &differenceRule);
+    return RET_OK;
+}
+
+enum ListReturnType integerListMergeJoin(struct List *list, struct List *other, IntegerCompareFunction compare,
+                                         ListJoinCallback callback, void *userData){
+    if((list == NULL) || (other == NULL) || (callback == NULL)) return RET_FAIL;
+    sortedSetPrepare(list, compare);
+    sortedSetPrepare(other, compare);
+
+    struct ListNode *nodeA = list->head;
+    struct ListNode *nodeB = other->head;
+    size_t winsA = 0;
+    size_t winsB = 0;
+    while((nodeA != NULL) && (nodeB != NULL)){
+        int32_t valueA = integerListNodeValue(nodeA);
+        int32_t valueB = integerListNodeValue(nodeB);
+        if(SORT_COMPARE(compare, valueA, valueB)){
+            winsB = 0;
+            nodeA = sortedSetStretch(nodeA, valueB, compare, &winsA)->next;
+        } else if(SORT_COMPARE(compare, valueB, valueA)){
+            winsA = 0;
+            nodeB = sortedSetStretch(nodeB, valueA, compare, &winsB)->next;
+        } else {
+            winsA = 0;
+            winsB = 0;
+            /* Find the groups of equal values and join every pair of them */
+            struct ListNode *endA = (nodeA->next != NULL) ? integerListGallop(nodeA->next, valueA, compare, false) : NULL;
+            struct ListNode *endB = (nodeB->next != NULL) ? integerListGallop(nodeB->next, valueB, compare, false) : NULL;
+            if(endA == NULL) endA = nodeA;
+            if(endB == NULL) endB = nodeB;
+            for(struct ListNode *a = nodeA; a != endA->next; a = a->next){
+                for(struct ListNode *b = nodeB; b != endB->next; b = b->next){
+                    if(!callback(a->value, b->value, userData)) return RET_OK;
+                }
+            }
+            nodeA = endA->next;
+            nodeB = endB->next;
+        }
+    }
+    return RET_OK;
+}
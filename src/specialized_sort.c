@@ -0,0 +1,51 @@
+#include "specialized_sort.h"
+#include "integer_list.h"
+#include <math.h>
+
+#define SORT_SCOPE
+#define SORT_NAME int32Ascending
+#define SORT_TYPE int32_t
+#define SORT_LIST_VALUE(node) integerListNodeValue(node)
+#define SORT_LIST_ORDER lessThan
+#include "sort_template.h"
+
+#define SORT_SCOPE
+#define SORT_NAME int32Descending
+#define SORT_TYPE int32_t
+#define SORT_LESS(a, b) ((a) > (b))
+#define SORT_LIST_VALUE(node) integerListNodeValue(node)
+#define SORT_LIST_ORDER greaterThan
+#include "sort_template.h"
+
+#define SORT_SCOPE
+#define SORT_NAME int64Ascending
+#define SORT_TYPE int64_t
+#include "sort_template.h"
+
+#define SORT_SCOPE
+#define SORT_NAME uint32Ascending
+#define SORT_TYPE uint32_t
+#include "sort_template.h"
+
+/* NaN is not ordered against anything, treat it as greater than every number */
+#define SORT_SCOPE
+#define SORT_NAME floatAscending
+#define SORT_TYPE float
+#define SORT_LESS(a, b) (((a) < (b)) || (isnan(b) && !isnan(a)))
+#include "sort_template.h"
+
+#define SORT_SCOPE
+#define SORT_NAME integerNodeAscending
+#define SORT_TYPE struct ListNode *
+#define SORT_KEY(node) integerListNodeValue(node)
+#include "sort_template.h"
+
+void integerListSpecializedSort(struct List *list, IntegerCompareFunction compare){
+    if(integerCompareIsAscending(compare)){
+        int32AscendingListSort(list);
+    } else if(compare == greaterThan){
+        int32DescendingListSort(list);
+    } else {
+        integerListMergeSortInPlace(list, compare);
+    }
+}
@@ -0,0 +1,289 @@
+#include "unrolled_list.h"
+#include "integer_list.h"
+#include "sort_stats.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Enough bins for any list that fits in memory, bin i holds a sorted run of 2^i nodes */
+#define UNROLLED_SORT_MAX_BINS (sizeof(size_t) * 8)
+
+/* A run of nodes being merged, NULL terminated through next */
+struct UnrolledRun {
+    struct UnrolledListNode *head;
+    struct UnrolledListNode *tail;
+};
+
+static struct UnrolledListNode *unrolledListNodeCreate(void){
+    return (struct UnrolledListNode *) xzalloc(1, sizeof(struct UnrolledListNode));
+}
+
+/**
+ * \brief Link a new empty node after previous, or at the head if previous is NULL
+ */
+static struct UnrolledListNode *unrolledListLinkNode(struct UnrolledList *list, struct UnrolledListNode *previous){
+    struct UnrolledListNode *node = unrolledListNodeCreate();
+    node->prev = previous;
+    node->next = (previous != NULL) ? previous->next : list->head;
+    if(node->next != NULL) {
+        node->next->prev = node;
+    } else {
+        list->tail = node;
+    }
+    if(previous != NULL) {
+        previous->next = node;
+    } else {
+        list->head = node;
+    }
+    list->nodeCount++;
+    return node;
+}
+
+static void unrolledListUnlinkNode(struct UnrolledList *list, struct UnrolledListNode *node){
+    if(node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if(node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+    list->nodeCount--;
+    free(node);
+}
+
+struct UnrolledList *unrolledListCreate(void){
+    return (struct UnrolledList *) xzalloc(1, sizeof(struct UnrolledList));
+}
+
+struct UnrolledList *unrolledListCreateWithElements(size_t count, int32_t elements[]){
+    struct UnrolledList *list = unrolledListCreate();
+    for(size_t i = 0; i < count; i++){
+        unrolledListAppendEnd(list, elements[i]);
+    }
+    return list;
+}
+
+void unrolledListDestroy(struct UnrolledList *list){
+    if(list == NULL) return;
+    struct UnrolledListNode *node = list->head;
+    while(node != NULL){
+        struct UnrolledListNode *next = node->next;
+        free(node);
+        node = next;
+    }
+    free(list);
+}
+
+enum ListReturnType unrolledListAppendStart(struct UnrolledList *list, int32_t value){
+    if(list == NULL) return RET_FAIL;
+    struct UnrolledListNode *node = list->head;
+    if((node == NULL) || (node->count == UNROLLED_LIST_NODE_CAPACITY)) {
+        node = unrolledListLinkNode(list, NULL);
+    }
+    memmove(node->values + 1, node->values, node->count * sizeof(int32_t));
+    node->values[0] = value;
+    node->count++;
+    list->count++;
+    return RET_OK;
+}
+
+enum ListReturnType unrolledListAppendEnd(struct UnrolledList *list, int32_t value){
+    if(list == NULL) return RET_FAIL;
+    struct UnrolledListNode *node = list->tail;
+    if((node == NULL) || (node->count == UNROLLED_LIST_NODE_CAPACITY)) {
+        node = unrolledListLinkNode(list, list->tail);
+    }
+    node->values[node->count++] = value;
+    list->count++;
+    return RET_OK;
+}
+
+enum ListReturnType unrolledListInsert(struct UnrolledList *list, size_t index, int32_t value){
+    if(list == NULL) return RET_FAIL;
+    if(index > list->count) return RET_FAIL;
+    if(index == list->count) return unrolledListAppendEnd(list, value);
+
+    /* Find the node holding the position */
+    struct UnrolledListNode *node = list->head;
+    while(index > node->count){
+        index -= node->count;
+        node = node->next;
+    }
+    if(node->count == UNROLLED_LIST_NODE_CAPACITY) {
+        /* Split the full node, moving its second half to a new node */
+        struct UnrolledListNode *half = unrolledListLinkNode(list, node);
+        size_t keep = UNROLLED_LIST_NODE_CAPACITY / 2;
+        half->count = node->count - keep;
+        memcpy(half->values, node->values + keep, half->count * sizeof(int32_t));
+        node->count = keep;
+        if(index > keep) {
+            index -= keep;
+            node = half;
+        }
+    }
+    memmove(node->values + index + 1, node->values + index, (node->count - index) * sizeof(int32_t));
+    node->values[index] = value;
+    node->count++;
+    list->count++;
+    return RET_OK;
+}
+
+enum ListReturnType unrolledListPop(struct UnrolledList *list, int32_t *value){
+    if((list == NULL) || (list->head == NULL)) return RET_FAIL;
+    struct UnrolledListNode *node = list->head;
+    if(value != NULL) *value = node->values[0];
+    node->count--;
+    memmove(node->values, node->values + 1, node->count * sizeof(int32_t));
+    if(node->count == 0) {
+        unrolledListUnlinkNode(list, node);
+    }
+    list->count--;
+    return RET_OK;
+}
+
+void unrolledListForEach(struct UnrolledList *list, ListCallback callback, void *userData){
+    if(list == NULL) return;
+    for(struct UnrolledListNode *node = list->head; node != NULL; node = node->next){
+        for(size_t i = 0; i < node->count; i++){
+            if(!callback(&node->values[i], userData)) return;
+        }
+    }
+}
+
+void unrolledListPrint(struct UnrolledList *list){
+    printf("[");
+    unrolledListForEach(list, integerListPrintElement, " %d ");
+    printf("]\n");
+}
+
+/**
+ * \brief Stable insertion sort of the values of a single node
+ */
+static void unrolledListNodeSort(struct UnrolledListNode *node, IntegerCompareFunction compare){
+    int32_t *values = node->values;
+    for(size_t i = 1; i < node->count; i++){
+        int32_t value = values[i];
+        size_t j = i;
+        while((j > 0) && SORT_COMPARE(compare, value, values[j - 1])){
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+/**
+ * \brief Add a value at the end of a run being built, packing the nodes
+ */
+static void unrolledRunAppend(struct UnrolledRun *run, int32_t value){
+    if((run->tail == NULL) || (run->tail->count == UNROLLED_LIST_NODE_CAPACITY)) {
+        struct UnrolledListNode *node = unrolledListNodeCreate();
+        node->prev = run->tail;
+        if(run->tail != NULL) {
+            run->tail->next = node;
+        } else {
+            run->head = node;
+        }
+        run->tail = node;
+    }
+    run->tail->values[run->tail->count++] = value;
+    SORT_STATS_ADD(nodeMoves, 1);
+}
+
+/**
+ * \brief Stable merge of 2 sorted runs into new packed nodes, on ties the values
+ * of the first run go first. The nodes of the input runs are freed as soon as
+ * all their values have been consumed.
+ */
+static struct UnrolledRun unrolledMergeRuns(struct UnrolledRun a, struct UnrolledRun b, IntegerCompareFunction compare){
+    /* The runs are already in order, just link them */
+    if(!SORT_COMPARE(compare, b.head->values[0], a.tail->values[a.tail->count - 1])) {
+        a.tail->next = b.head;
+        b.head->prev = a.tail;
+        a.tail = b.tail;
+        return a;
+    }
+
+    SORT_STATS_ADD(merges, 1);
+    struct UnrolledRun result = {0};
+    struct UnrolledListNode *nodeA = a.head;
+    struct UnrolledListNode *nodeB = b.head;
+    size_t indexA = 0;
+    size_t indexB = 0;
+    while((nodeA != NULL) && (nodeB != NULL)){
+        if(SORT_COMPARE(compare, nodeB->values[indexB], nodeA->values[indexA])) {
+            unrolledRunAppend(&result, nodeB->values[indexB]);
+            if(++indexB == nodeB->count) {
+                struct UnrolledListNode *next = nodeB->next;
+                free(nodeB);
+                nodeB = next;
+                indexB = 0;
+            }
+        } else {
+            unrolledRunAppend(&result, nodeA->values[indexA]);
+            if(++indexA == nodeA->count) {
+                struct UnrolledListNode *next = nodeA->next;
+                free(nodeA);
+                nodeA = next;
+                indexA = 0;
+            }
+        }
+    }
+    /* Copy what is left of the remaining run */
+    struct UnrolledListNode *node = (nodeA != NULL) ? nodeA : nodeB;
+    size_t index = (nodeA != NULL) ? indexA : indexB;
+    while(node != NULL){
+        for(; index < node->count; index++){
+            unrolledRunAppend(&result, node->values[index]);
+        }
+        struct UnrolledListNode *next = node->next;
+        free(node);
+        node = next;
+        index = 0;
+    }
+    return result;
+}
+
+void unrolledListSort(struct UnrolledList *list, IntegerCompareFunction compare){
+    if((list == NULL) || (list->count <= 1)) return;
+
+    struct UnrolledRun bins[UNROLLED_SORT_MAX_BINS] = {{0}};
+    size_t usedBins = 0;
+
+    /* Sort every node and merge them like a binary counter */
+    struct UnrolledListNode *node = list->head;
+    while(node != NULL){
+        struct UnrolledListNode *next = node->next;
+        node->next = NULL;
+        node->prev = NULL;
+        unrolledListNodeSort(node, compare);
+        struct UnrolledRun carry = { .head = node, .tail = node };
+        size_t i = 0;
+        while(bins[i].head != NULL){
+            carry = unrolledMergeRuns(bins[i], carry, compare);
+            bins[i].head = NULL;
+            bins[i].tail = NULL;
+            i++;
+        }
+        bins[i] = carry;
+        if(i >= usedBins) usedBins = i + 1;
+        node = next;
+    }
+
+    struct UnrolledRun result = {0};
+    for(size_t i = 0; i < usedBins; i++){
+        if(bins[i].head == NULL) continue;
+        result = (result.head == NULL) ? bins[i] : unrolledMergeRuns(bins[i], result, compare);
+    }
+
+    list->head = result.head;
+    list->tail = result.tail;
+    list->nodeCount = 0;
+    for(node = list->head; node != NULL; node = node->next){
+        list->nodeCount++;
+    }
+}
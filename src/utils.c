@@ -1,9 +1,12 @@
 #include "utils.h"
+#include "sort_stats.h"
 #include <stdio.h>
 
 void *xzalloc(size_t count, size_t size){
     /* calloc initializes the new memory to 0  so there is no need to
      * explicitly do it here */
+    SORT_STATS_ADD(allocations, 1);
+    SORT_STATS_ADD(allocatedBytes, count * size);
     void *ptr = calloc(count, size);
     if(ptr == NULL){
         fprintf(stderr, "Error: Failed to reserve memory");
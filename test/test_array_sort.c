@@ -0,0 +1,381 @@
+/*
+ * Tests for the sorting algorithms working on contiguous arrays of integers.
+ *  Every test sorts a copy of the input and compares it against the output
+ *  of the standard qsort.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "array_sort.h"
+#include "parallel_sort.h"
+#include "partial_sort.h"
+#include "simd_sort.h"
+#include "specialized_sort.h"
+#include "integer_list.h"
+#include "external_sort.h"
+#include "utils.h"
+
+#define ARRAY_SIZE(x) sizeof((x))/sizeof((x)[0])
+
+/**
+ * \brief Compare function for qsort, used to build the expected results
+ */
+int compareIntegers(const void *a, const void *b){
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * \brief Data type for the array sorting functions under test
+ */
+typedef void ArraySortFunction(int32_t *values, size_t count, struct ArraySortScratch *scratch);
+
+/**
+ * \brief Merge sort with the default compare function
+ */
+void mergeSortForTesting(int32_t *values, size_t count, struct ArraySortScratch *scratch){
+    integerArrayMergeSort(values, count, lessThan, scratch);
+}
+
+/**
+ * \brief Parallel merge sort with a small cutoff, so the arrays are split between 3 threads
+ */
+void parallelSortForTesting(int32_t *values, size_t count, struct ArraySortScratch *scratch){
+    integerArrayParallelMergeSort(values, count, lessThan, 3, 4, scratch);
+}
+
+/**
+ * \brief Parallel radix sort with a small cutoff, so the arrays are split between 3 threads
+ */
+void parallelRadixSortForTesting(int32_t *values, size_t count, struct ArraySortScratch *scratch){
+    integerArrayParallelRadixSort(values, count, 3, 4, scratch);
+}
+
+/**
+ * \brief Sort specialized for ascending int32_t values, with the scratch buffer of the other sorts
+ */
+void int32AscendingSortForTesting(int32_t *values, size_t count, struct ArraySortScratch *scratch){
+    int32AscendingSort(values, count, (scratch != NULL) ? arraySortScratchReserve(scratch, count) : NULL);
+}
+
+/**
+ * \brief Run an array Sort test case
+ * This function copies the values, sorts them with the given function and
+ * compares the output against the values sorted by qsort.
+ * \param iteration    Number of the test to be printed
+ * \param size         Size of the values array
+ * \param sortFunction Function under test
+ * \param values       Initial state of the array
+ * \param scratch      Scratch buffer passed to the sort function, can be NULL
+ */
+void runArraySortTest(int iteration, size_t size, ArraySortFunction sortFunction, int32_t *values, struct ArraySortScratch *scratch){
+    printf("\n-- Array Test %d --\n", iteration);
+    printf("Array Size = %lu\n", (unsigned long int) size);
+
+    int32_t *output = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    int32_t *expected = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    memcpy(output, values, size * sizeof(int32_t));
+    memcpy(expected, values, size * sizeof(int32_t));
+    qsort(expected, size, sizeof(int32_t), compareIntegers);
+
+    clock_t start, end;
+    start = clock();
+    sortFunction(output, size, scratch);
+    end = clock();
+
+    bool succeeded = (memcmp(output, expected, size * sizeof(int32_t)) == 0);
+    free(output);
+    free(expected);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+    printf("Resolved sort in %.3f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run the sorts specialized for other types and orders on the values
+ * converted to each type, checking that the result is ordered and stable.
+ */
+void runSpecializedSortTest(int iteration, size_t size, int32_t *values){
+    printf("\n-- Specialized Sort Test %d --\n", iteration);
+    printf("Array Size = %lu\n", (unsigned long int) size);
+
+    int32_t *descending = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    int64_t *wide = (int64_t *) xzalloc(size + 1, sizeof(int64_t));
+    uint32_t *unsignedValues = (uint32_t *) xzalloc(size + 1, sizeof(uint32_t));
+    float *floats = (float *) xzalloc(size + 1, sizeof(float));
+    struct ListNode **nodes = (struct ListNode **) xzalloc(size + 1, sizeof(struct ListNode *));
+    /* The nodes live in one block, so their addresses follow the original order */
+    struct ListNode *nodeBlock = (struct ListNode *) xzalloc(size + 1, sizeof(struct ListNode));
+    int32_t *nodeValues = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    for(size_t i = 0; i < size; i++){
+        descending[i] = values[i];
+        wide[i] = (int64_t) values[i] * 4096;
+        unsignedValues[i] = (uint32_t) values[i];
+        floats[i] = (i % 97 == 13) ? NAN : (float) values[i] / 8;
+        nodeValues[i] = values[i];
+        nodeBlock[i].value = &nodeValues[i];
+        nodes[i] = &nodeBlock[i];
+    }
+
+    struct List *list = integerListCreateWithElements(size, values);
+    int32DescendingListSort(list);
+    int32DescendingSort(descending, size, NULL);
+    int64AscendingSort(wide, size, NULL);
+    uint32AscendingSort(unsignedValues, size, NULL);
+    floatAscendingSort(floats, size, NULL);
+    integerNodeAscendingSort(nodes, size, NULL);
+
+    /* The list must hold the same values as the array, with valid links in both directions */
+    bool succeeded = (listSortedCount(list, (const void *) greaterThan) == size) && (list->count == size);
+    size_t position = 0;
+    for(struct ListNode *node = list->head; (node != NULL) && succeeded; node = node->next, position++){
+        succeeded = (integerListNodeValue(node) == descending[position]) &&
+                    ((node->next != NULL) ? (node->next->prev == node) : (list->tail == node));
+    }
+    succeeded = succeeded && (position == size);
+    listDestroy(list);
+
+    bool nanFound = false;
+    for(size_t i = 1; i < size; i++){
+        succeeded = succeeded && (descending[i - 1] >= descending[i]);
+        succeeded = succeeded && (wide[i - 1] <= wide[i]);
+        succeeded = succeeded && (unsignedValues[i - 1] <= unsignedValues[i]);
+        /* NaN values go last, the numbers before them are ascending */
+        nanFound = nanFound || isnan(floats[i - 1]);
+        succeeded = succeeded && (nanFound ? isnan(floats[i]) : (isnan(floats[i]) || (floats[i - 1] <= floats[i])));
+        int32_t previous = integerListNodeValue(nodes[i - 1]);
+        int32_t current = integerListNodeValue(nodes[i]);
+        /* Equal values keep their addresses ascending when the sort is stable */
+        succeeded = succeeded && ((previous < current) || ((previous == current) && (nodes[i - 1] < nodes[i])));
+    }
+    free(descending);
+    free(wide);
+    free(unsignedValues);
+    free(floats);
+    free(nodes);
+    free(nodeBlock);
+    free(nodeValues);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run an array Select test case
+
+ * The selected value must match the values sorted by qsort and the array must
+ * keep all its values, partitioned around position k.
+ * \param iteration Number of the test to be printed
+ * \param k         Position to be selected
+ * \param size      Size of the values array
+ * \param values    Initial state of the array
+ */
+void runArraySelectTest(int iteration, size_t k, size_t size, int32_t *values){
+    printf("\n-- Array Select Test %d --\n", iteration);
+    printf("Array Size = %lu, k = %lu\n", (unsigned long int) size, (unsigned long int) k);
+
+    int32_t *output = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    int32_t *expected = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    memcpy(output, values, size * sizeof(int32_t));
+    memcpy(expected, values, size * sizeof(int32_t));
+    qsort(expected, size, sizeof(int32_t), compareIntegers);
+
+    int32_t selected = 0;
+    bool succeeded = (integerArraySelect(output, size, k, lessThan, &selected) == RET_OK);
+    succeeded = succeeded && (selected == expected[k]) && (output[k] == selected);
+    for(size_t i = 0; i < size; i++){
+        succeeded = succeeded && ((i < k) ? (output[i] <= selected) : (output[i] >= selected));
+    }
+    qsort(output, size, sizeof(int32_t), compareIntegers);
+    succeeded = succeeded && (memcmp(output, expected, size * sizeof(int32_t)) == 0);
+    free(output);
+    free(expected);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a sorting network kernel test case
+ * Every block size from 0 to SIMD_SORT_BLOCK_SIZE is taken from the start of
+ * the values, sorted with the kernel and compared against qsort.
+ * \param iteration Number of the test to be printed
+ * \param kernel    Kernel under test, skipped if the processor lacks it
+ * \param values    Initial state of the blocks, at least SIMD_SORT_BLOCK_SIZE values
+ */
+void runSimdSortTest(int iteration, enum SimdSortKernel kernel, int32_t *values){
+    printf("\n-- Kernel Test %d --\n", iteration);
+    printf("Kernel = %s\n", simdSortKernelName(kernel));
+
+    enum SimdSortKernel previous = simdSortKernel();
+    bool succeeded = true;
+    if(simdSortSetKernel(kernel)){
+        for(size_t count = 0; count <= SIMD_SORT_BLOCK_SIZE; count++){
+            int32_t output[SIMD_SORT_BLOCK_SIZE];
+            int32_t expected[SIMD_SORT_BLOCK_SIZE];
+            memcpy(output, values, count * sizeof(int32_t));
+            memcpy(expected, values, count * sizeof(int32_t));
+            qsort(expected, count, sizeof(int32_t), compareIntegers);
+            int32SortBlock(output, count);
+            succeeded = succeeded && (memcmp(output, expected, count * sizeof(int32_t)) == 0);
+        }
+        simdSortSetKernel(previous);
+    } else {
+        printf("Kernel not supported by the processor\n");
+    }
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run an External Sort test case
+ * The values are written to a temporary file, sorted by externalSortFile and
+ * read back to be compared against the values sorted by qsort.
+ * \param iteration    Number of the test to be printed
+ * \param size         Size of the values array
+ * \param values       Values to be written to the input file
+ * \param memoryBudget Memory budget of the sort in bytes
+ * \param maxFanIn     Maximum amount of runs merged at once, 0 for the default
+ * \param inPlace      Use the input file as the output file
+ */
+void runExternalSortTest(int iteration, size_t size, int32_t *values, size_t memoryBudget, size_t maxFanIn, bool inPlace){
+    printf("\n-- External Test %d --\n", iteration);
+    printf("Array Size = %lu, Memory Budget = %lu, Max Fan In = %lu\n", (unsigned long int) size,
+           (unsigned long int) memoryBudget, (unsigned long int) maxFanIn);
+
+    char inputPath[] = "/tmp/mergesort-test-in-XXXXXX";
+    char outputPath[] = "/tmp/mergesort-test-out-XXXXXX";
+    int inputFd = mkstemp(inputPath);
+    int outputFd = mkstemp(outputPath);
+    bool succeeded = (inputFd >= 0) && (outputFd >= 0) &&
+                     (write(inputFd, values, size * sizeof(int32_t)) == (ssize_t) (size * sizeof(int32_t)));
+    close(inputFd);
+    close(outputFd);
+
+    struct ExternalSortOptions options;
+    externalSortDefaultOptions(&options);
+    options.memoryBudget = memoryBudget;
+    options.maxFanIn = maxFanIn;
+    const char *resultPath = inPlace ? inputPath : outputPath;
+    succeeded = succeeded && (externalSortFile(inputPath, resultPath, &options) == RET_OK);
+
+    int32_t *output = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    int32_t *expected = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    memcpy(expected, values, size * sizeof(int32_t));
+    qsort(expected, size, sizeof(int32_t), compareIntegers);
+    FILE *result = fopen(resultPath, "rb");
+    succeeded = succeeded && (result != NULL) && (fread(output, sizeof(int32_t), size + 1, result) == size) &&
+                (memcmp(output, expected, size * sizeof(int32_t)) == 0);
+    if(result != NULL) fclose(result);
+    unlink(inputPath);
+    unlink(outputPath);
+    free(output);
+    free(expected);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+#define TEST_LARGE_ARRAY_SIZE 1000000
+
+int main(int argc, const char **argv){
+    int32_t test1[] = {1, 18, 3, 7, 9, 6, 106, 2, 75, 10, 5, -1};
+    int32_t test2[] = {INT32_MAX, 0, INT32_MIN, -1, 1, INT32_MIN + 1, INT32_MAX - 1, 256, -256, 65536, -65536, 0};
+    static int32_t test3[TEST_LARGE_ARRAY_SIZE];
+    static int32_t test4[TEST_LARGE_ARRAY_SIZE];
+    static int32_t test5[TEST_LARGE_ARRAY_SIZE];
+
+    srand(1);
+    for(size_t i = 0; i < TEST_LARGE_ARRAY_SIZE; i++){
+        test3[i] = (int32_t) (((uint32_t) rand() << 16) ^ (uint32_t) rand());  /* Full range values */
+        test4[i] = (rand() % 2000) - 1000;                                     /* Few unique, small values */
+        test5[i] = (int32_t) (TEST_LARGE_ARRAY_SIZE - i);                      /* Descending */
+    }
+
+    struct ArraySortScratch *scratch = arraySortScratchCreate(0);
+
+    runArraySortTest(0, 0, integerArrayRadixSort, test1, NULL);
+    runArraySortTest(1, ARRAY_SIZE(test1), integerArrayRadixSort, test1, NULL);
+    runArraySortTest(2, ARRAY_SIZE(test2), integerArrayRadixSort, test2, scratch);
+    runArraySortTest(3, ARRAY_SIZE(test3), integerArrayRadixSort, test3, NULL);
+    runArraySortTest(4, ARRAY_SIZE(test3), integerArrayRadixSort, test3, scratch);
+    runArraySortTest(5, ARRAY_SIZE(test4), integerArrayRadixSort, test4, scratch);
+    runArraySortTest(6, ARRAY_SIZE(test5), integerArrayRadixSort, test5, scratch);
+
+    runArraySortTest(7, ARRAY_SIZE(test1), mergeSortForTesting, test1, NULL);
+    runArraySortTest(8, ARRAY_SIZE(test2), mergeSortForTesting, test2, scratch);
+    runArraySortTest(9, ARRAY_SIZE(test3), mergeSortForTesting, test3, scratch);
+    runArraySortTest(10, ARRAY_SIZE(test4), mergeSortForTesting, test4, NULL);
+
+    runArraySortTest(11, ARRAY_SIZE(test1), parallelSortForTesting, test1, NULL);
+    runArraySortTest(12, ARRAY_SIZE(test2), parallelSortForTesting, test2, scratch);
+    runArraySortTest(13, ARRAY_SIZE(test3), parallelSortForTesting, test3, scratch);
+    runArraySortTest(14, ARRAY_SIZE(test4), parallelSortForTesting, test4, NULL);
+    runArraySortTest(15, ARRAY_SIZE(test5), parallelSortForTesting, test5, scratch);
+
+    runExternalSortTest(16, 0, test1, 1024 * 1024, 0, false);
+    runExternalSortTest(17, ARRAY_SIZE(test2), test2, 1024 * 1024, 0, false);
+    runExternalSortTest(18, ARRAY_SIZE(test3), test3, 256 * 1024, 0, false);
+    runExternalSortTest(19, ARRAY_SIZE(test3), test3, 256 * 1024, 4, false);
+    runExternalSortTest(20, ARRAY_SIZE(test4), test4, 1024 * 1024, 3, true);
+    runExternalSortTest(21, ARRAY_SIZE(test5), test5, 64 * 1024 * 1024, 0, true);
+
+    int32_t test6[SIMD_SORT_BLOCK_SIZE];
+    for(size_t i = 0; i < SIMD_SORT_BLOCK_SIZE; i++){
+        test6[i] = (i % 3 == 0) ? INT32_MAX : ((i % 3 == 1) ? INT32_MIN : (int32_t) (i % 5));
+    }
+    runSimdSortTest(22, SIMD_SORT_SCALAR, test3);
+    runSimdSortTest(23, SIMD_SORT_SSE41, test3);
+    runSimdSortTest(24, SIMD_SORT_AVX2, test3);
+    runSimdSortTest(25, SIMD_SORT_SSE41, test6);
+    runSimdSortTest(26, SIMD_SORT_AVX2, test6);
+    runSimdSortTest(27, SIMD_SORT_AVX2, test5);
+
+    runArraySelectTest(28, 0, ARRAY_SIZE(test1), test1);
+    runArraySelectTest(29, ARRAY_SIZE(test2) - 1, ARRAY_SIZE(test2), test2);
+    runArraySelectTest(30, ARRAY_SIZE(test3) / 2, ARRAY_SIZE(test3), test3);
+    runArraySelectTest(31, ARRAY_SIZE(test4) * 99 / 100, ARRAY_SIZE(test4), test4);
+    runArraySelectTest(32, ARRAY_SIZE(test5) / 4, ARRAY_SIZE(test5), test5);
+
+    runArraySortTest(33, ARRAY_SIZE(test1), int32AscendingSortForTesting, test1, NULL);
+    runArraySortTest(34, ARRAY_SIZE(test2), int32AscendingSortForTesting, test2, scratch);
+    runArraySortTest(35, ARRAY_SIZE(test3), int32AscendingSortForTesting, test3, NULL);
+    runArraySortTest(36, ARRAY_SIZE(test4), int32AscendingSortForTesting, test4, scratch);
+    runSpecializedSortTest(37, ARRAY_SIZE(test2), test2);
+    runSpecializedSortTest(38, ARRAY_SIZE(test4), test4);
+    runSpecializedSortTest(39, ARRAY_SIZE(test5), test5);
+
+    runArraySortTest(40, ARRAY_SIZE(test1), parallelRadixSortForTesting, test1, NULL);
+    runArraySortTest(41, ARRAY_SIZE(test2), parallelRadixSortForTesting, test2, scratch);
+    runArraySortTest(42, ARRAY_SIZE(test3), parallelRadixSortForTesting, test3, NULL);
+    runArraySortTest(43, ARRAY_SIZE(test4), parallelRadixSortForTesting, test4, scratch);
+    runArraySortTest(44, ARRAY_SIZE(test5), parallelRadixSortForTesting, test5, scratch);
+
+    arraySortScratchDestroy(scratch);
+    return 0;
+}
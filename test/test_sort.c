@@ -15,16 +15,32 @@
  *        abort.
  */
 
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
 #include "list.h"
 #include "integer_list.h"
 #include "utils.h"
 #include "merge_sort.h"
+#include "parallel_sort.h"
+#include "adaptive_sort.h"
+#include "gather_sort.h"
+#include "partial_sort.h"
+#include "skip_list.h"
+#include "specialized_sort.h"
+#include "node_pool.h"
+#include "unrolled_list.h"
+#include "compact_list.h"
+#include "file_view.h"
+#include "record_sort.h"
+#include "sorted_set.h"
+#include "sort_stats.h"
 
 #define ARRAY_SIZE(x) sizeof((x))/sizeof((x)[0])
 
@@ -35,14 +51,26 @@ struct TestExpectedValueData {
     bool result;                /* Total result of the comparison */
 };
 
-static int comparisons = 0;
+/* Counted from the worker threads of the parallel sorts as well, so it is only accessed atomically */
+static uint64_t comparisons = 0;
+/* Kind of list created by the tests */
+enum TestListKind {
+    TEST_LIST_BOXED,    /* Values reserved separately from the nodes */
+    TEST_LIST_POOLED,   /* Nodes and values taken from a pool */
+    TEST_LIST_INLINE,   /* Values stored inline in the nodes */
+    TEST_LIST_BULK      /* Nodes and values built at once in a single block */
+};
+
+static enum TestListKind testListKind = TEST_LIST_BOXED;
+/* Set by the sorts under test that replace the compare function, so no comparisons are seen */
+static bool compareReplaced = false;
 
 void resetComparisons(void){
-    comparisons = 0;
+    __atomic_store_n(&comparisons, 0, __ATOMIC_RELAXED);
 }
 
-int getComparisons(void){
-    return comparisons;
+uint64_t getComparisons(void){
+    return __atomic_load_n(&comparisons, __ATOMIC_RELAXED);
 }
 
 /**
@@ -51,10 +79,59 @@ int getComparisons(void){
  * back to the test.
  */
 bool lessThanForTesting(int32_t a, int32_t b) {
-    comparisons++;
+    __atomic_fetch_add(&comparisons, 1, __ATOMIC_RELAXED);
     return a < b;
 }
 
+/**
+ * \brief Parallel sort with a small cutoff, so the test lists are split between 4 threads
+ */
+void parallelSortForTesting(struct List *list, IntegerCompareFunction compare){
+    integerListParallelMergeSort(list, compare, 4, 8);
+}
+
+/**
+ * \brief In place merge sort with the default compare function, so the blocks
+ * are sorted by the sorting network kernel. No comparisons are counted.
+ */
+void blockSortForTesting(struct List *list, IntegerCompareFunction compare){
+    compareReplaced = true;
+    integerListMergeSortInPlace(list, lessThan);
+}
+
+/**
+ * \brief Gather sort writing back the values, with the compare function under test
+ */
+void gatherValuesSortForTesting(struct List *list, IntegerCompareFunction compare){
+    integerListGatherSort(list, compare, GATHER_SORT_VALUES, NULL);
+}
+
+/**
+ * \brief Gather sort relinking the nodes with the default compare function, so
+ * the pairs are sorted by the radix sort. No comparisons are counted.
+ */
+void gatherRadixRelinkSortForTesting(struct List *list, IntegerCompareFunction compare){
+    compareReplaced = true;
+    integerListGatherSort(list, lessThan, GATHER_SORT_RELINK, NULL);
+}
+
+/**
+ * \brief Merge sort specialized for ascending values, with the compare function
+ * inlined. No comparisons are counted.
+ */
+void specializedSortForTesting(struct List *list, IntegerCompareFunction compare){
+    compareReplaced = true;
+    int32AscendingListSort(list);
+}
+
+/**
+ * \brief Parallel radix sort split between 3 threads. No comparisons are counted.
+ */
+void parallelRadixSortForTesting(struct List *list, IntegerCompareFunction compare){
+    compareReplaced = true;
+    integerListParallelRadixSort(list, 3);
+}
+
 /**
  * \brief Callback for comparing one of the values in a List to an array of expected values.
  * \param value Pointer to the value stored in the list
@@ -94,6 +171,35 @@ bool compareTestResults(size_t size, struct List *values, int32_t *expected){
     return data.result;
 }
 
+/**
+ * \brief Checks that the links, head, tail and count of a list are consistent.
+ * \param list The list to be checked
+ */
+bool checkListLinks(struct List *list){
+    struct ListNode *prev = NULL;
+    size_t count = 0;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next){
+        if(node->prev != prev) return false;
+        prev = node;
+        count++;
+    }
+    return (list->tail == prev) && (list->count == count);
+}
+
+/**
+ * \brief Creates the list for a test, the kind of list is selected by testListKind.
+ */
+struct List *createTestList(size_t size, int32_t *values){
+    if(testListKind == TEST_LIST_INLINE) return integerListCreateInlineWithElements(size, values);
+    if(testListKind == TEST_LIST_BOXED) return integerListCreateWithElements(size, values);
+    if(testListKind == TEST_LIST_BULK) return integerListCreateBulk(size, values);
+    struct List *list = integerListCreatePooled(1024);
+    for(size_t i=0; i<size; i++) {
+        integerListAppendEnd(list, values[i]);
+    }
+    return list;
+}
+
 /**
  * \brief Run a Sort test case
  * This function creates a list based on a set of integers, sorts the list and
@@ -107,7 +213,7 @@ void runSortTest(int iteration, size_t size, SortFunction sortFunction, int32_t
     printf("\n-- Test %d --\n", iteration);
 
     resetComparisons();
-    struct List *list = integerListCreateWithElements(size, values);
+    struct List *list = createTestList(size, values);
     printf("List Size = %lu\n", (unsigned long int) size);
     printf("Input:\n");
     if(size<100) integerListPrint(list);
@@ -116,18 +222,32 @@ void runSortTest(int iteration, size_t size, SortFunction sortFunction, int32_t
     clock_t start, end;
     double cpu_time_used;
 
+    sortStatsReset();
+    compareReplaced = false;
     start = clock();
     sortFunction(list, lessThanForTesting);
     end = clock();
     cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
 
+    struct SortStats stats;
+    sortStatsGet(&stats);
+
     printf("Output:\n");
     if(size<100) integerListPrint(list);
     else printf("Too large to be printed\n");
 
-    bool succeeded = compareTestResults(size, list, expected);
+    bool succeeded = compareTestResults(size, list, expected) && checkListLinks(list);
     listDestroy(list);
-    printf("\nComparisons = %d\n",getComparisons());
+    printf("\nComparisons = %llu\n", (unsigned long long) getComparisons());
+    if(sortStatsEnabled()) {
+        /* The library must count the same comparisons seen by the compare function,
+         * unless the sort under test replaced it and none must be seen */
+        succeeded = succeeded && (compareReplaced ? (getComparisons() == 0) : (stats.comparisons == getComparisons()));
+        printf("Stats: moves = %llu, merges = %llu, passes = %llu, allocations = %llu (%llu bytes)\n",
+               (unsigned long long) stats.nodeMoves, (unsigned long long) stats.merges,
+               (unsigned long long) stats.mergePasses, (unsigned long long) stats.allocations,
+               (unsigned long long) stats.allocatedBytes);
+    }
 
     printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
 
@@ -138,15 +258,1148 @@ void runSortTest(int iteration, size_t size, SortFunction sortFunction, int32_t
     }
 }
 
+/**
+ * \brief Run a Merge test case
+ * This function creates 2 sorted lists, merges them with integerListMergeSortMerge
+ * and compares the output against an expected output. The right list is of the
+ * kind selected by testListKind and the kind of the left list changes with iteration.
+ * \param iteration Number of the test to be printed
+ * \param minGallop Consecutive wins before galloping, 0 disables it
+ * \param sizeA     Size of the valuesA array
+ * \param valuesA   Sorted values of the right list
+ * \param sizeB     Size of the valuesB array
+ * \param valuesB   Sorted values of the left list
+ * \param expected  Expected merged values, sizeA+sizeB elements
+ */
+void runMergeTest(int iteration, size_t minGallop, size_t sizeA, int32_t *valuesA, size_t sizeB, int32_t *valuesB, int32_t *expected){
+    printf("\n-- Merge Test %d --\n", iteration);
+
+    resetComparisons();
+    struct List *right = createTestList(sizeA, valuesA);
+    enum TestListKind kind = testListKind;
+    testListKind = (enum TestListKind) (iteration % (TEST_LIST_BULK + 1));
+    struct List *left = createTestList(sizeB, valuesB);
+    testListKind = kind;
+    printf("List Sizes = %lu + %lu, Min Gallop = %lu\n", (unsigned long int) sizeA,
+           (unsigned long int) sizeB, (unsigned long int) minGallop);
+
+    integerListMergeSetMinGallop(minGallop);
+    bool succeeded = (integerListMergeSortMerge(&right, left, lessThanForTesting) == RET_OK);
+    integerListMergeSetMinGallop(MERGE_SORT_DEFAULT_MIN_GALLOP);
+
+    succeeded = succeeded && compareTestResults(sizeA + sizeB, right, expected) && checkListLinks(right);
+    listDestroy(right);
+    printf("Comparisons = %llu\n", (unsigned long long) getComparisons());
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Check that the nodes released to a pool are reused by the next insertions
+ */
+void runPoolReuseTest(void){
+    printf("\n-- Pool Reuse Test --\n");
+    int32_t values[] = {5, 4, 3, 2, 1};
+    int32_t expected[] = {1, 2, 3, 4, 5};
+    struct List *list = integerListCreatePooled(ARRAY_SIZE(values));
+    for(size_t i=0; i<ARRAY_SIZE(values); i++) {
+        integerListAppendEnd(list, 0);
+    }
+    for(size_t i=0; i<ARRAY_SIZE(values); i++) {
+        listNodeFree(list, listPop(list));
+        integerListAppendEnd(list, values[i]);
+    }
+    integerListMergeSortInPlace(list, lessThan);
+    bool succeeded = compareTestResults(ARRAY_SIZE(expected), list, expected) && checkListLinks(list) &&
+                     (list->pool->blockCount == 1);
+    listDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Check that the nodes appended to a bulk list are reserved in small blocks
+ */
+void runBulkGrowthTest(size_t size, int32_t *values){
+    printf("\n-- Bulk Growth Test --\n");
+    struct List *list = integerListCreateBulk(size, values);
+    bool succeeded = (list->pool->blockCount == 1);
+    for(size_t i = 0; i < INTEGER_LIST_BULK_GROWTH + 1; i++) {
+        integerListAppendEnd(list, values[i % size]);
+    }
+    succeeded = succeeded && (list->pool->blockCount == 3) && (list->pool->slotsPerBlock == INTEGER_LIST_BULK_GROWTH) &&
+                (list->count == size + INTEGER_LIST_BULK_GROWTH + 1) && checkListLinks(list);
+    listDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Checks that the links and counters of an Unrolled List are consistent.
+ * \param list The list to be checked
+ */
+bool checkUnrolledListLinks(struct UnrolledList *list){
+    struct UnrolledListNode *prev = NULL;
+    size_t count = 0;
+    size_t nodeCount = 0;
+    for(struct UnrolledListNode *node = list->head; node != NULL; node = node->next){
+        if((node->prev != prev) || (node->count == 0)) return false;
+        prev = node;
+        count += node->count;
+        nodeCount++;
+    }
+    return (list->tail == prev) && (list->count == count) && (list->nodeCount == nodeCount);
+}
+
+/**
+ * \brief Run an Unrolled List Sort test case
+ * \param iteration Number of the test to be printed
+ * \param size      Size of both the values and expected arrays
+ * \param values    Initial state of the list
+ * \param expected  Expected final state for the list
+ */
+void runUnrolledSortTest(int iteration, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Unrolled Test %d --\n", iteration);
+
+    resetComparisons();
+    struct UnrolledList *list = unrolledListCreateWithElements(size, values);
+    printf("List Size = %lu\n", (unsigned long int) size);
+
+    clock_t start, end;
+    start = clock();
+    unrolledListSort(list, lessThanForTesting);
+    end = clock();
+
+    if(size<100) unrolledListPrint(list);
+
+    struct TestExpectedValueData data = {
+        .size = size,
+        .expectedValues = expected,
+        .iterator = 0,
+        .result = true
+    };
+    unrolledListForEach(list, checkExpectedElement, &data);
+    bool succeeded = data.result && (data.iterator == size) && checkUnrolledListLinks(list);
+    unrolledListDestroy(list);
+    printf("\nComparisons = %llu\n", (unsigned long long) getComparisons());
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    printf("Resolved sort in %.3f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Check the insertions and pops of an Unrolled List, splitting full nodes
+ */
+void runUnrolledInsertTest(void){
+    printf("\n-- Unrolled Insert Test --\n");
+    size_t size = 4 * UNROLLED_LIST_NODE_CAPACITY;
+    struct UnrolledList *list = unrolledListCreate();
+    bool succeeded = true;
+    /* Build 0..size-1 by adding the odd values at the end, then inserting the even ones */
+    for(size_t i = 1; i < size; i += 2) {
+        unrolledListAppendEnd(list, i);
+    }
+    unrolledListAppendStart(list, 0);
+    for(size_t i = 2; i < size; i += 2) {
+        succeeded = succeeded && (unrolledListInsert(list, i, i) == RET_OK);
+    }
+    succeeded = succeeded && (unrolledListInsert(list, size + 1, 0) == RET_FAIL) && checkUnrolledListLinks(list);
+    for(size_t i = 0; i < size; i++) {
+        int32_t value;
+        succeeded = succeeded && (unrolledListPop(list, &value) == RET_OK) && (value == (int32_t) i);
+    }
+    succeeded = succeeded && (unrolledListPop(list, NULL) == RET_FAIL) && checkUnrolledListLinks(list);
+    unrolledListDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Check that the next and prev indices of a Compact List are consistent
+ */
+bool checkCompactListLinks(struct CompactList *list){
+    uint32_t prev = COMPACT_LIST_NIL;
+    size_t count = 0;
+    for(uint32_t node = list->head; node != COMPACT_LIST_NIL; node = list->nodes[node].next){
+        if((list->nodes[node].prev != prev) || (count >= list->used)) return false;
+        prev = node;
+        count++;
+    }
+    return (list->tail == prev) && (list->count == count);
+}
+
+/**
+ * \brief Run a Compact List Sort test case
+ * \param iteration Number of the test to be printed
+ * \param size      Size of both the values and expected arrays
+ * \param values    Initial state of the list
+ * \param expected  Expected final state for the list
+ */
+void runCompactSortTest(int iteration, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Compact Test %d --\n", iteration);
+
+    resetComparisons();
+    sortStatsReset();
+    struct CompactList *list = compactListCreateWithElements(size, values);
+    printf("List Size = %lu\n", (unsigned long int) size);
+
+    clock_t start, end;
+    start = clock();
+    compactListSort(list, lessThanForTesting);
+    end = clock();
+
+    if(size<100) compactListPrint(list);
+
+    struct TestExpectedValueData data = {
+        .size = size,
+        .expectedValues = expected,
+        .iterator = 0,
+        .result = true
+    };
+    compactListForEach(list, checkExpectedElement, &data);
+    bool succeeded = data.result && (data.iterator == size) && checkCompactListLinks(list);
+    /* The nodes are reserved at once */
+    succeeded = succeeded && (list->capacity == size) && (list->used == size);
+    compactListDestroy(list);
+    printf("\nComparisons = %llu\n", (unsigned long long) getComparisons());
+    if(sortStatsEnabled()) {
+        struct SortStats stats;
+        sortStatsGet(&stats);
+        succeeded = succeeded && (stats.comparisons == getComparisons());
+    }
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    printf("Resolved sort in %.3f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Check the insertions, removals and pops of a Compact List, growing its
+ * storage and reusing the indices of removed nodes
+ */
+void runCompactInsertTest(void){
+    printf("\n-- Compact Insert Test --\n");
+    size_t size = 4 * COMPACT_LIST_DEFAULT_CAPACITY + 3;
+    struct CompactList *list = compactListCreate(0);
+    bool succeeded = (list->head == COMPACT_LIST_NIL) && (compactListPop(list, NULL) == RET_FAIL);
+    /* Build 0..size-1 by adding the odd values at the end, then inserting the even ones after them */
+    uint32_t *odd = (uint32_t *) xzalloc(size, sizeof(uint32_t));
+    for(size_t i = 1; i < size; i += 2) {
+        succeeded = succeeded && (compactListAppendEnd(list, i) == RET_OK);
+        odd[i] = list->tail;
+    }
+    succeeded = succeeded && (compactListAppendStart(list, 0) == RET_OK);
+    for(size_t i = 2; i < size; i += 2) {
+        succeeded = succeeded && (compactListInsertAfter(list, odd[i - 1], i) != COMPACT_LIST_NIL);
+    }
+    succeeded = succeeded && (list->count == size) && checkCompactListLinks(list);
+
+    /* Removing the odd values frees their indices, adding them again must not grow the storage */
+    size_t used = list->used;
+    for(size_t i = 1; i < size; i += 2) {
+        succeeded = succeeded && (compactListRemove(list, odd[i]) == RET_OK);
+    }
+    succeeded = succeeded && checkCompactListLinks(list);
+    for(size_t i = 1; i < size; i += 2) {
+        succeeded = succeeded && (compactListAppendEnd(list, i) == RET_OK);
+    }
+    succeeded = succeeded && (list->used == used) && checkCompactListLinks(list);
+
+    compactListSort(list, lessThan);
+    for(size_t i = 0; i < size; i++) {
+        int32_t value;
+        succeeded = succeeded && (compactListPop(list, &value) == RET_OK) && (value == (int32_t) i);
+    }
+    succeeded = succeeded && (compactListPop(list, NULL) == RET_FAIL) && checkCompactListLinks(list);
+    succeeded = succeeded && (list->head == COMPACT_LIST_NIL) && (list->tail == COMPACT_LIST_NIL);
+    free(odd);
+    compactListDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/* A record sorted by several keys, position is its place in the original list */
+struct TestRecord {
+    int64_t wide;
+    uint64_t unsignedKey;
+    double real;
+    char name[12];
+    size_t position;
+};
+
+void testRecordWideKey(const void *value, struct RecordKey *key){
+    key->int64 = ((const struct TestRecord *) value)->wide;
+}
+
+void testRecordUnsignedKey(const void *value, struct RecordKey *key){
+    key->uint64 = ((const struct TestRecord *) value)->unsignedKey;
+}
+
+void testRecordRealKey(const void *value, struct RecordKey *key){
+    key->real = ((const struct TestRecord *) value)->real;
+}
+
+void testRecordNameKey(const void *value, struct RecordKey *key){
+    const struct TestRecord *record = (const struct TestRecord *) value;
+    key->bytes = record->name;
+    key->size = strlen(record->name);
+}
+
+void freeRecordNodeForTesting(struct ListNode *node){
+    free(node);
+}
+
+/**
+ * \brief Tells if the key of record a goes before the key of record b
+ */
+bool testRecordLess(enum RecordKeyType type, const struct TestRecord *a, const struct TestRecord *b){
+    switch(type){
+        case RECORD_KEY_INT64:
+            return a->wide < b->wide;
+        case RECORD_KEY_UINT64:
+            return a->unsignedKey < b->unsignedKey;
+        case RECORD_KEY_DOUBLE: {
+            /* Negative NaN, the numbers with -0 before +0, positive NaN */
+            int classA = isnan(a->real) ? (signbit(a->real) ? 0 : 2) : 1;
+            int classB = isnan(b->real) ? (signbit(b->real) ? 0 : 2) : 1;
+            if(classA != classB) return classA < classB;
+            return (classA == 1) && ((a->real < b->real) ||
+                                     ((a->real == b->real) && signbit(a->real) && !signbit(b->real)));
+        }
+        default: {
+            size_t sizeA = strlen(a->name);
+            size_t sizeB = strlen(b->name);
+            int order = memcmp(a->name, b->name, (sizeA < sizeB) ? sizeA : sizeB);
+            return (order < 0) || ((order == 0) && (sizeA < sizeB));
+        }
+    }
+}
+
+/**
+ * \brief Run a Record Sort test case
+ * Records are built from the values and sorted by every key type. The records
+ * must be ordered by the key and keep their original order for equal keys.
+ * \param iteration Number of the test to be printed
+ * \param size      Size of the values array
+ * \param values    Values the records are built from
+ */
+void runRecordSortTest(int iteration, size_t size, int32_t *values){
+    printf("\n-- Record Sort Test %d --\n", iteration);
+    printf("List Size = %lu\n", (unsigned long int) size);
+
+    struct TestRecord *records = (struct TestRecord *) xzalloc(size + 1, sizeof(struct TestRecord));
+    for(size_t i = 0; i < size; i++){
+        records[i].wide = (int64_t) values[i] * 65536 - 7;
+        records[i].unsignedKey = (uint64_t) (uint32_t) values[i] << 24;
+        switch(i % 101){
+            case 7:  records[i].real = NAN; break;
+            case 11: records[i].real = -NAN; break;
+            case 13: records[i].real = -0.0; break;
+            case 17: records[i].real = -INFINITY; break;
+            case 19: records[i].real = INFINITY; break;
+            default: records[i].real = (double) values[i] / 8;
+        }
+        snprintf(records[i].name, sizeof(records[i].name), "%x", (unsigned int) values[i] & 0xFFFFF);
+        records[i].position = i;
+    }
+
+    enum RecordKeyType types[] = { RECORD_KEY_INT64, RECORD_KEY_UINT64, RECORD_KEY_DOUBLE, RECORD_KEY_BYTES };
+    RecordKeyFunction *keys[] = { testRecordWideKey, testRecordUnsignedKey, testRecordRealKey, testRecordNameKey };
+    bool succeeded = (listRecordSort(NULL, RECORD_KEY_INT64, testRecordWideKey) == RET_FAIL);
+    clock_t start, end;
+    start = clock();
+    for(size_t k = 0; k < ARRAY_SIZE(types); k++){
+        struct List *list = listCreate(freeRecordNodeForTesting);
+        for(size_t i = 0; i < size; i++) listAppendEnd(list, listNodeCreate(&records[i]));
+        succeeded = succeeded && (listRecordSort(list, types[k], keys[k]) == RET_OK);
+        succeeded = succeeded && checkListLinks(list) && (list->count == size) &&
+                    (listSortedCount(list, (const void *) keys[k]) == size);
+        for(struct ListNode *node = list->head; (node != NULL) && (node->next != NULL) && succeeded; node = node->next){
+            const struct TestRecord *a = (const struct TestRecord *) node->value;
+            const struct TestRecord *b = (const struct TestRecord *) node->next->value;
+            succeeded = testRecordLess(types[k], a, b) ||
+                        (!testRecordLess(types[k], b, a) && (a->position < b->position));
+        }
+        if(size > 1){
+            /* A key changed inside a record is seen by the next sort with the same key function */
+            struct TestRecord *first = (struct TestRecord *) list->head->value;
+            struct TestRecord saved = *first;
+            first->wide = INT64_MAX;
+            first->unsignedKey = UINT64_MAX;
+            first->real = NAN;
+            snprintf(first->name, sizeof(first->name), "zz");
+            succeeded = succeeded && (listRecordSort(list, types[k], keys[k]) == RET_OK) &&
+                        (list->head->value != first) && checkListLinks(list);
+            for(struct ListNode *node = list->head; (node->next != NULL) && succeeded; node = node->next){
+                succeeded = !testRecordLess(types[k], node->next->value, node->value);
+            }
+            *first = saved;
+        }
+        listDestroy(list);
+    }
+    end = clock();
+    free(records);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+    printf("Resolved sort in %.3f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a K-way Merge test case
+ * The values are split in parts lists of every kind, every list is sorted and
+ * then all of them are merged with integerListMergeMany.
+ * \param iteration Number of the test to be printed
+ * \param parts     Amount of lists to be merged
+ * \param size      Size of both the values and expected arrays
+ * \param values    Values to be split in the lists
+ * \param expected  Expected merged values
+ */
+void runMergeManyTest(int iteration, size_t parts, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Merge Many Test %d --\n", iteration);
+    printf("List Size = %lu, Lists = %lu\n", (unsigned long int) size, (unsigned long int) parts);
+
+    struct List **lists = (struct List **) xzalloc(parts, sizeof(struct List *));
+    enum TestListKind kind = testListKind;
+    for(size_t p = 0; p < parts; p++){
+        /* Uneven parts, the first list takes the remainder and some lists may be empty */
+        size_t first = (p == 0) ? 0 : (size / parts) * p + size % parts;
+        size_t count = (p == 0) ? size / parts + size % parts : size / parts;
+        /* Boxed, pooled, inline and bulk lists are mixed, the nodes can not always be moved */
+        testListKind = (enum TestListKind) ((p + iteration) % (TEST_LIST_BULK + 1));
+        lists[p] = createTestList(count, values + first);
+        integerListMergeSortInPlace(lists[p], lessThan);
+    }
+    testListKind = kind;
+
+    resetComparisons();
+    bool succeeded = (integerListMergeMany(lists, parts, lessThanForTesting) == RET_OK);
+
+    succeeded = succeeded && compareTestResults(size, lists[0], expected) && checkListLinks(lists[0]);
+    for(size_t p = 0; p < parts; p++){
+        succeeded = succeeded && ((p == 0) || ((lists[p]->count == 0) && checkListLinks(lists[p])));
+        listDestroy(lists[p]);
+    }
+    free(lists);
+    printf("Comparisons = %llu\n", (unsigned long long) getComparisons());
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a Partial Sort test case
+ * The first k values of the list must match the sorted values, the rest of the
+ * list must keep the original order of the values that were not selected.
+ * integerListTopK with greaterThan is checked against the largest k values.
+ * \param iteration Number of the test to be printed
+ * \param k         Amount of values to be sorted
+ * \param size      Size of the values array
+ * \param values    Initial state of the list
+ * \param expected  The values sorted in ascending order
+ */
+void runPartialSortTest(int iteration, size_t k, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Partial Sort Test %d --\n", iteration);
+    printf("List Size = %lu, k = %lu\n", (unsigned long int) size, (unsigned long int) k);
+
+    size_t selected = (k < size) ? k : size;
+    int32_t *expectedList = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    memcpy(expectedList, expected, selected * sizeof(int32_t));
+    if(selected > 0){
+        /* The selected values are the ones below the last selected value, plus the
+         * first occurrences of the last selected value */
+        int32_t last = expected[selected - 1];
+        size_t lastTaken = 0;
+        for(size_t i = 0; i < selected; i++){
+            if(expected[i] == last) lastTaken++;
+        }
+        size_t rest = selected;
+        for(size_t i = 0; i < size; i++){
+            if(values[i] < last) continue;
+            if((values[i] == last) && (lastTaken > 0)){
+                lastTaken--;
+                continue;
+            }
+            expectedList[rest++] = values[i];
+        }
+    } else {
+        memcpy(expectedList, values, size * sizeof(int32_t));
+    }
+
+    struct List *list = createTestList(size, values);
+    resetComparisons();
+    bool succeeded = (integerListPartialSort(list, k, lessThanForTesting) == RET_OK);
+    printf("Comparisons = %llu\n", (unsigned long long) getComparisons());
+    succeeded = succeeded && compareTestResults(size, list, expectedList) && checkListLinks(list);
+
+    int32_t *largest = (int32_t *) xzalloc(selected + 1, sizeof(int32_t));
+    succeeded = succeeded && (integerListTopK(list, k, greaterThan, largest) == selected);
+    for(size_t i = 0; i < selected; i++){
+        succeeded = succeeded && (largest[i] == expected[size - 1 - i]);
+    }
+    succeeded = succeeded && compareTestResults(size, list, expectedList);
+    listDestroy(list);
+    free(largest);
+    free(expectedList);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Compare function for qsort, used to build the expected results
+ */
+int compareIntegers(const void *a, const void *b){
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* State of the merge join callback of the tests */
+struct TestJoinData {
+    size_t pairs;
+    int64_t sum;
+    int32_t previous;
+    bool ordered;
+};
+
+bool testJoinCallback(void *value, void *otherValue, void *userData){
+    struct TestJoinData *data = (struct TestJoinData *) userData;
+    int32_t a = *(int32_t *) value;
+    int32_t b = *(int32_t *) otherValue;
+    data->ordered = data->ordered && (a == b) && ((data->pairs == 0) || (data->previous <= a));
+    data->previous = a;
+    data->pairs++;
+    data->sum += a;
+    return true;
+}
+
+/**
+ * \brief Check a list built by a sorted set operation against the expected values
+ */
+bool checkSortedSetResult(struct List *list, struct List *other, size_t size, int32_t *expected){
+    return (list->count == size) && compareTestResults(size, list, expected) && checkListLinks(list) &&
+           (other->count == 0) && (other->head == NULL) && (other->tail == NULL) &&
+           (listSortedCount(list, (const void *) lessThanForTesting) == size);
+}
+
+/**
+ * \brief Run a Sorted Set test case
+ * The values are put in 2 unsorted lists, every operation is checked against
+ * the same operation done on the sorted arrays.
+ * \param iteration Number of the test to be printed
+ * \param sizeA     Size of the valuesA array
+ * \param valuesA   Values of the first list
+ * \param sizeB     Size of the valuesB array
+ * \param valuesB   Values of the second list
+ */
+void runSortedSetTest(int iteration, size_t sizeA, int32_t *valuesA, size_t sizeB, int32_t *valuesB){
+    printf("\n-- Sorted Set Test %d --\n", iteration);
+    printf("List Sizes = %lu, %lu\n", (unsigned long int) sizeA, (unsigned long int) sizeB);
+
+    int32_t *a = (int32_t *) xzalloc(sizeA + 1, sizeof(int32_t));
+    int32_t *b = (int32_t *) xzalloc(sizeB + 1, sizeof(int32_t));
+    int32_t *expected = (int32_t *) xzalloc(sizeA + sizeB + 1, sizeof(int32_t));
+    memcpy(a, valuesA, sizeA * sizeof(int32_t));
+    memcpy(b, valuesB, sizeB * sizeof(int32_t));
+    qsort(a, sizeA, sizeof(int32_t), compareIntegers);
+    qsort(b, sizeB, sizeof(int32_t), compareIntegers);
+
+    /* Unique */
+    size_t size = 0;
+    for(size_t i = 0; i < sizeA; i++){
+        if((i == 0) || (a[i] != a[i - 1])) expected[size++] = a[i];
+    }
+    struct List *list = createTestList(sizeA, valuesA);
+    struct List *other = createTestList(0, valuesB);
+    bool succeeded = (integerListUnique(NULL, lessThanForTesting) == RET_FAIL);
+    succeeded = succeeded && (integerListUnique(list, lessThanForTesting) == RET_OK);
+    succeeded = succeeded && checkSortedSetResult(list, other, size, expected);
+    listDestroy(list);
+    listDestroy(other);
+
+    /* Union, intersection and difference, the matches pair the values one by one */
+    for(int operation = 0; operation < 3; operation++){
+        size_t i = 0;
+        size_t j = 0;
+        size = 0;
+        while((i < sizeA) || (j < sizeB)){
+            if((j == sizeB) || ((i < sizeA) && (a[i] < b[j]))){
+                if(operation != 1) expected[size++] = a[i];
+                i++;
+            } else if((i == sizeA) || (b[j] < a[i])){
+                if(operation == 0) expected[size++] = b[j];
+                j++;
+            } else {
+                if(operation != 2) expected[size++] = a[i];
+                i++;
+                j++;
+            }
+        }
+        list = createTestList(sizeA, valuesA);
+        other = createTestList(sizeB, valuesB);
+        enum ListReturnType result;
+        if(operation == 0){
+            result = integerListUnion(list, other, lessThanForTesting);
+        } else if(operation == 1){
+            result = integerListIntersection(list, other, lessThanForTesting);
+        } else {
+            result = integerListDifference(list, other, lessThanForTesting);
+        }
+        succeeded = succeeded && (result == RET_OK) && checkSortedSetResult(list, other, size, expected);
+        succeeded = succeeded && (integerListUnion(list, list, lessThanForTesting) == RET_FAIL);
+        listDestroy(list);
+        listDestroy(other);
+    }
+
+    /* Merge join, every pair of equal values */
+    struct TestJoinData expectedJoin = { .ordered = true };
+    for(size_t i = 0, j = 0; (i < sizeA) && (j < sizeB);){
+        if(a[i] < b[j]){
+            i++;
+        } else if(b[j] < a[i]){
+            j++;
+        } else {
+            size_t endA = i;
+            size_t endB = j;
+            while((endA < sizeA) && (a[endA] == a[i])) endA++;
+            while((endB < sizeB) && (b[endB] == b[j])) endB++;
+            expectedJoin.pairs += (endA - i) * (endB - j);
+            expectedJoin.sum += (int64_t) a[i] * (int64_t) ((endA - i) * (endB - j));
+            i = endA;
+            j = endB;
+        }
+    }
+    struct TestJoinData join = { .ordered = true };
+    list = createTestList(sizeA, valuesA);
+    other = createTestList(sizeB, valuesB);
+    succeeded = succeeded && (integerListMergeJoin(list, other, lessThanForTesting, testJoinCallback, &join) == RET_OK);
+    succeeded = succeeded && join.ordered && (join.pairs == expectedJoin.pairs) && (join.sum == expectedJoin.sum);
+    succeeded = succeeded && (list->count == sizeA) && (other->count == sizeB) && checkListLinks(list) && checkListLinks(other);
+    listDestroy(list);
+    listDestroy(other);
+
+    free(a);
+    free(b);
+    free(expected);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Check the union of lists whose nodes can not be moved between them.
+ * The values kept from a view are copied into the other list, so the list
+ * stays valid after the view is destroyed, and a view can not receive values.
+ */
+void runSortedSetViewTest(size_t sizeA, int32_t *valuesA, size_t sizeB, int32_t *valuesB){
+    printf("\n-- Sorted Set View Test --\n");
+    int32_t *expected = (int32_t *) xzalloc(sizeA + sizeB + 1, sizeof(int32_t));
+    memcpy(expected, valuesA, sizeA * sizeof(int32_t));
+    memcpy(expected + sizeA, valuesB, sizeB * sizeof(int32_t));
+    qsort(expected, sizeA + sizeB, sizeof(int32_t), compareIntegers);
+    size_t size = 0;
+    for(size_t i = 0; i < sizeA + sizeB; i++){
+        if((i == 0) || (expected[i] != expected[size - 1])) expected[size++] = expected[i];
+    }
+
+    struct List *list = integerListCreateWithElements(sizeA, valuesA);
+    struct List *view = integerListCreateView(sizeB, valuesB);
+    integerListUnique(list, lessThanForTesting);
+    integerListUnique(view, lessThanForTesting);
+    bool succeeded = (integerListUnion(view, list, lessThanForTesting) == RET_FAIL) && (list->count > 0);
+    succeeded = succeeded && (integerListUnion(list, view, lessThanForTesting) == RET_OK);
+    listDestroy(view);
+    succeeded = succeeded && (list->count == size) && compareTestResults(size, list, expected) && checkListLinks(list);
+    listDestroy(list);
+    free(expected);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a test of the gather sort with a caller scratch buffer
+ * The scratch grows on the first sort and is reused by the next ones.
+ * \param size     Size of the values array
+ * \param values   Initial state of the list
+ * \param expected The values sorted in ascending order
+ */
+void runGatherScratchTest(size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Gather Scratch Test --\n");
+    struct ArraySortScratch *scratch = arraySortScratchCreate(0);
+    bool succeeded = true;
+    int32_t *buffer = NULL;
+    for(int i = 0; i < 2; i++){
+        IntegerCompareFunction *compare = (i == 0) ? lessThan : lessThanForTesting;
+        struct List *list = integerListCreateWithElements(size, values);
+        succeeded = succeeded && (integerListGatherSort(list, compare, GATHER_SORT_VALUES, scratch) == RET_OK);
+        succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+        succeeded = succeeded && (scratch->capacity >= 2 * size) && ((buffer == NULL) || (scratch->buffer == buffer));
+        buffer = scratch->buffer;
+        listDestroy(list);
+    }
+    arraySortScratchDestroy(scratch);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a test of a compare function declared as ascending
+ * Once declared, lessThanForTesting must take the fast paths of lessThan, so
+ * the in place merge sort counts fewer comparisons and the radix sort of the
+ * gather relink sort none.
+ * \param size     Size of the values array
+ * \param values   Initial state of the list
+ * \param expected The values sorted in ascending order
+ */
+void runAscendingCompareTest(size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Ascending Compare Test --\n");
+    SortFunction *sorts[] = { integerListMergeSortInPlace, integerListGatherRelinkSort };
+    uint64_t counted[2][2];
+    bool succeeded = integerCompareIsAscending(lessThan) && !integerCompareIsAscending(lessThanForTesting) &&
+                     !integerCompareIsAscending(greaterThan) && !integerCompareIsAscending(NULL);
+    for(int declared = 0; declared < 2; declared++){
+        integerCompareSetAscending(declared ? lessThanForTesting : NULL);
+        succeeded = succeeded && (integerCompareIsAscending(lessThanForTesting) == declared);
+        for(size_t i = 0; i < ARRAY_SIZE(sorts); i++){
+            struct List *list = integerListCreateWithElements(size, values);
+            uint64_t before = getComparisons();
+            sorts[i](list, lessThanForTesting);
+            counted[declared][i] = getComparisons() - before;
+            succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+            listDestroy(list);
+        }
+    }
+    integerCompareSetAscending(NULL);
+    succeeded = succeeded && !integerCompareIsAscending(lessThanForTesting) && integerCompareIsAscending(lessThan);
+    succeeded = succeeded && (counted[1][0] < counted[0][0]) && (counted[0][1] > 0) && (counted[1][1] == 0);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a test of the blocks of the in place merge sort
+ * The nodes must be relinked in a stable order and keep their own values.
+ * \param size   Size of the values array
+ * \param values Initial state of the list
+ */
+void runBlockRelinkTest(size_t size, int32_t *values){
+    printf("\n-- Block Relink Test --\n");
+    struct List *list = integerListCreateBulk(size, values);
+    struct ListNode **nodes = (struct ListNode **) xzalloc(size, sizeof(struct ListNode *));
+    size_t count = 0;
+    for(struct ListNode *node = list->head; node != NULL; node = node->next) nodes[count++] = node;
+
+    integerListMergeSortInPlace(list, lessThan);
+    bool succeeded = (count == size) && checkListLinks(list);
+    for(size_t i = 0; succeeded && (i < size); i++){
+        succeeded = (integerListNodeValue(nodes[i]) == values[i]);
+    }
+    size_t previous = 0;
+    for(struct ListNode *node = list->head; succeeded && (node != NULL); node = node->next){
+        size_t position = 0;
+        while(nodes[position] != node) position++;
+        if(node != list->head){
+            int32_t value = integerListNodeValue(node);
+            int32_t previousValue = values[previous];
+            succeeded = (previousValue < value) || ((previousValue == value) && (previous < position));
+        }
+        previous = position;
+    }
+    free(nodes);
+    listDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a Select test case
+ * The selected value must match the sorted values, the list must keep all its
+ * values and be partitioned around position k.
+ * \param iteration Number of the test to be printed
+ * \param k         Position to be selected
+ * \param size      Size of the values array
+ * \param values    Initial state of the list
+ * \param expected  The values sorted in ascending order
+ */
+void runSelectTest(int iteration, size_t k, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Select Test %d --\n", iteration);
+    printf("List Size = %lu, k = %lu\n", (unsigned long int) size, (unsigned long int) k);
+
+    struct List *list = createTestList(size, values);
+    int32_t selected = 0;
+    resetComparisons();
+    bool succeeded = (integerListSelect(list, k, lessThanForTesting, &selected) == RET_OK);
+    printf("Comparisons = %llu\n", (unsigned long long) getComparisons());
+    succeeded = succeeded && (selected == expected[k]) && checkListLinks(list);
+
+    int32_t *output = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    size_t i = 0;
+    for(struct ListNode *node = list->head; (node != NULL) && (i < size); node = node->next, i++){
+        output[i] = integerListNodeValue(node);
+        succeeded = succeeded && ((i < k) ? (output[i] <= selected) : (output[i] >= selected));
+        succeeded = succeeded && ((i != k) || (output[i] == selected));
+    }
+    qsort(output, i, sizeof(int32_t), compareIntegers);
+    succeeded = succeeded && (i == size) && (memcmp(output, expected, size * sizeof(int32_t)) == 0);
+    free(output);
+    listDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run an Incremental Sort test case
+ * The first sortedSize values are sorted, the rest are appended at the end and
+ * the list is sorted again with integerListIncrementalSort, which has to merge
+ * the appended values with less comparisons than a full sort. The tracking of
+ * the sorted prefix by pop, insertions and partial sorts is checked as well.
+ * \param iteration  Number of the test to be printed
+ * \param sortedSize Amount of values sorted before the appends
+ * \param size       Size of the values array
+ * \param values     Values of the list
+ * \param expected   The values sorted in ascending order
+ */
+void runIncrementalSortTest(int iteration, size_t sortedSize, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- Incremental Sort Test %d --\n", iteration);
+    printf("List Size = %lu, Sorted Prefix = %lu\n", (unsigned long int) size, (unsigned long int) sortedSize);
+
+    struct List *list = createTestList(sortedSize, values);
+    bool succeeded = (listSortedCount(list, (const void *) lessThanForTesting) == 0);
+    integerListIncrementalSort(list, lessThanForTesting);
+    for(size_t i = sortedSize; i < size; i++){
+        integerListAppendEnd(list, values[i]);
+    }
+    succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == sortedSize);
+    succeeded = succeeded && (listSortedCount(list, (const void *) greaterThan) == 0);
+
+    resetComparisons();
+    integerListIncrementalSort(list, lessThanForTesting);
+    printf("Comparisons = %llu\n", (unsigned long long) getComparisons());
+    succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+    succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == size);
+    if(sortedSize > size / 2){
+        /* Merging into a large prefix must be cheaper than sorting the whole list */
+        succeeded = succeeded && (getComparisons() < size * 4);
+    }
+
+    /* Sorting again only checks the recorded prefix */
+    resetComparisons();
+    integerListIncrementalSort(list, lessThanForTesting);
+    succeeded = succeeded && (getComparisons() < size);
+
+    if(size > 2){
+        struct ListNode *node = listPop(list);
+        succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == size - 1);
+        listInsertAfter(list, list->head, node);
+        succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == 0);
+        integerListPartialSort(list, 2, lessThanForTesting);
+        succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == 2);
+        integerListIncrementalSort(list, lessThanForTesting);
+        succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+        integerListAppendStart(list, 0);
+        succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == 0);
+        integerListIncrementalSort(list, lessThanForTesting);
+
+        /* Swapping through the list resets the prefix */
+        integerListSwapValues(list, list->head, list->tail);
+        succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == 0);
+        integerListIncrementalSort(list, lessThanForTesting);
+        succeeded = succeeded && checkListLinks(list) &&
+                    (listSortedCount(list, (const void *) lessThanForTesting) == size + 1);
+
+        /* A value written through a node is not seen by the list, the prefix is checked anyway */
+        *(int32_t *) list->head->value = INT32_MAX;
+        integerListIncrementalSort(list, lessThanForTesting);
+        succeeded = succeeded && checkListLinks(list) && (integerListNodeValue(list->tail) == INT32_MAX);
+        for(struct ListNode *node = list->head; (node->next != NULL) && succeeded; node = node->next){
+            succeeded = (integerListNodeValue(node) <= integerListNodeValue(node->next));
+        }
+    }
+    listDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run an Adaptive Sort test case
+ * The list is sorted by integerListAdaptiveSortWithReport, the strategy reported
+ * must be the expected one and the output must match the expected values.
+ * \param iteration Number of the test to be printed
+ * \param compare   Compare function, lessThan allows the radix strategy
+ * \param size      Size of the values array
+ * \param values    Initial state of the list
+ * \param expected  Expected sorted values
+ * \param strategy  Strategy that should be chosen
+ */
+void runAdaptiveSortTest(int iteration, IntegerCompareFunction compare, size_t size, int32_t *values, int32_t *expected,
+                         enum AdaptiveSortStrategy strategy){
+    printf("\n-- Adaptive Sort Test %d --\n", iteration);
+    printf("List Size = %lu\n", (unsigned long int) size);
+
+    struct List *list = createTestList(size, values);
+    struct AdaptiveSortReport report;
+    bool succeeded = (integerListAdaptiveSortWithReport(list, compare, &report) == RET_OK);
+    printf("Strategy = %s, runs = %lu, descents = %lu, breaks = %lu/%lu, inversions = %lu, range = [%d, %d]\n",
+           adaptiveSortStrategyName(report.strategy), (unsigned long int) report.estimatedRuns,
+           (unsigned long int) report.descents, (unsigned long int) report.runBreaks,
+           (unsigned long int) report.sampledPairs,
+           (unsigned long int) report.inversions, report.minimum, report.maximum);
+    succeeded = succeeded && (report.strategy == strategy) && (report.count == size);
+    succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+
+    /* The list is known to be sorted now, so sorting it again does nothing */
+    succeeded = succeeded && (integerListAdaptiveSortWithReport(list, compare, &report) == RET_OK);
+    succeeded = succeeded && (report.strategy == ADAPTIVE_SORT_NONE);
+
+    /* A value written through a node is not seen by the list, the sorted mark must not be trusted */
+    if(size > 1){
+        *(int32_t *) list->head->value = INT32_MAX;
+        succeeded = succeeded && (listSortedCount(list, (const void *) compare) == size);
+        succeeded = succeeded && (integerListAdaptiveSortWithReport(list, compare, &report) == RET_OK);
+        succeeded = succeeded && (report.strategy != ADAPTIVE_SORT_NONE) && checkListLinks(list) &&
+                    (integerListNodeValue(list->tail) == INT32_MAX);
+        for(struct ListNode *node = list->head; (node->next != NULL) && succeeded; node = node->next){
+            succeeded = !compare(integerListNodeValue(node->next), integerListNodeValue(node));
+        }
+    }
+    listDestroy(list);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Sort views over an array with several sorts, including the ones that
+ * write values back with lessThan. The views must end sorted, with the array untouched.
+ * \param size     Amount of values in the array
+ * \param values   Array under the views
+ * \param expected Expected sorted values
+ */
+bool checkViewSorts(size_t size, const int32_t *values, int32_t *expected){
+    /* An empty file view has no values at all */
+    int32_t *original = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    if(size > 0) memcpy(original, values, size * sizeof(int32_t));
+
+    SortFunction *sorts[] = { integerListMergeSortInPlace, integerListHybridSort, integerListAdaptiveSort,
+                              integerListParallelSort, integerListIncrementalSort, naiveSort,
+                              parallelRadixSortForTesting };
+    bool succeeded = true;
+    integerListGatherSetThreshold(0);
+    for(size_t i = 0; i < ARRAY_SIZE(sorts); i++){
+        if((sorts[i] == naiveSort) && (size > 1000)) continue;
+        struct List *list = integerListCreateView(size, values);
+        succeeded = succeeded && list->readOnly && (integerListAppendEnd(list, 0) == RET_FAIL) && (list->count == size);
+        succeeded = succeeded && (integerListSwapValues(list, list->head, list->tail) == RET_FAIL);
+        sorts[i](list, lessThan);
+        succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+        if(size > 0){
+            /* Nodes can be removed from a view */
+            struct ListNode *node = list->head;
+            succeeded = succeeded && (listRemove(list, node) == RET_OK) && checkListLinks(list);
+            listNodeFree(list, node);
+        }
+        listDestroy(list);
+    }
+    integerListGatherSetThreshold(GATHER_SORT_DEFAULT_THRESHOLD);
+    succeeded = succeeded && ((size == 0) || (memcmp(original, values, size * sizeof(int32_t)) == 0));
+    free(original);
+    return succeeded;
+}
+
+/**
+ * \brief Run a View test case
+ * The values are seen through views over the array and through a view over a
+ * temporary file holding them.
+ * \param iteration Number of the test to be printed
+ * \param size      Size of the values array
+ * \param values    Values seen by the views
+ * \param expected  Expected sorted values
+ */
+void runViewTest(int iteration, size_t size, int32_t *values, int32_t *expected){
+    printf("\n-- View Test %d --\n", iteration);
+    printf("List Size = %lu\n", (unsigned long int) size);
+
+    bool succeeded = checkViewSorts(size, values, expected);
+
+    char path[] = "/tmp/test_view_XXXXXX";
+    int fd = mkstemp(path);
+    succeeded = succeeded && (fd >= 0);
+    if(fd >= 0){
+        succeeded = succeeded && (write(fd, values, size * sizeof(int32_t)) == (ssize_t) (size * sizeof(int32_t)));
+        close(fd);
+        struct IntegerFileView *view = integerFileViewOpen(path);
+        succeeded = succeeded && (view != NULL) && (view->count == size) && (view->list->count == size);
+        if(view != NULL){
+            /* The file is mapped read only, writing a value would crash */
+            succeeded = succeeded && (integerListSwapValues(view->list, view->list->head, view->list->tail) == RET_FAIL);
+            integerListMergeSortInPlace(view->list, lessThan);
+            succeeded = succeeded && compareTestResults(size, view->list, expected) && checkListLinks(view->list);
+            succeeded = succeeded && checkViewSorts(view->count, view->values, expected);
+            integerFileViewClose(view);
+        }
+        unlink(path);
+    }
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
+/**
+ * \brief Run a Skip List test case
+ * The first half of the values builds the list, the second half is inserted
+ * through the index. Then every other value is searched and removed, and the
+ * list must hold the remaining values in order with consistent links.
+ * \param iteration Number of the test to be printed
+ * \param size      Size of the values array
+ * \param values    Values to be inserted
+ */
+void runSkipListTest(int iteration, size_t size, int32_t *values){
+    printf("\n-- Skip List Test %d --\n", iteration);
+    printf("List Size = %lu\n", (unsigned long int) size);
+
+    struct List *list = createTestList(size / 2, values);
+    struct SkipListIndex *index = skipListIndexCreate(list, lessThanForTesting);
+    bool succeeded = (index != NULL);
+    resetComparisons();
+    for(size_t i = size / 2; i < size; i++){
+        struct ListNode *node = skipListIndexInsert(index, values[i]);
+        succeeded = succeeded && (node != NULL) && (integerListNodeValue(node) == values[i]);
+    }
+    printf("Insert Comparisons = %llu\n", (unsigned long long) getComparisons());
+
+    int32_t *expected = (int32_t *) xzalloc(size + 1, sizeof(int32_t));
+    memcpy(expected, values, size * sizeof(int32_t));
+    qsort(expected, size, sizeof(int32_t), compareIntegers);
+    succeeded = succeeded && compareTestResults(size, list, expected) && checkListLinks(list);
+    succeeded = succeeded && (listSortedCount(list, (const void *) lessThanForTesting) == size);
+
+    /* Searches, values below, between and above the stored ones */
+    for(size_t i = 0; i < size; i++){
+        struct ListNode *node = skipListIndexFind(index, expected[i]);
+        succeeded = succeeded && (node != NULL) && (integerListNodeValue(node) == expected[i]);
+        succeeded = succeeded && ((node == NULL) || (node->prev == NULL) || (integerListNodeValue(node->prev) < expected[i]));
+        struct ListNode *bound = skipListIndexLowerBound(index, expected[i] + 1);
+        succeeded = succeeded && ((bound == NULL) || (integerListNodeValue(bound) > expected[i]));
+    }
+    if(size > 0){
+        succeeded = succeeded && (skipListIndexLowerBound(index, INT32_MIN) == list->head);
+        succeeded = succeeded && ((expected[size - 1] == INT32_MAX) || (skipListIndexLowerBound(index, expected[size - 1] + 1) == NULL));
+    }
+
+    /* Remove the values at the even positions of the input */
+    size_t remaining = 0;
+    for(size_t i = 0; i < size; i++){
+        if(i % 2 == 0){
+            succeeded = succeeded && (skipListIndexRemove(index, values[i]) == RET_OK);
+        } else {
+            expected[remaining++] = values[i];
+        }
+    }
+    qsort(expected, remaining, sizeof(int32_t), compareIntegers);
+    succeeded = succeeded && (list->count == remaining) && compareTestResults(remaining, list, expected) && checkListLinks(list);
+    succeeded = succeeded && ((remaining == 0) || (skipListIndexRemove(index, expected[0] - 1) == RET_FAIL) || (expected[0] == INT32_MIN));
+
+    skipListIndexDestroy(index);
+    listDestroy(list);
+    free(expected);
+
+    printf("Condition: %s\n", succeeded ? "PASSED" : "FAILED");
+
+    if(!succeeded){
+        abort();
+    }
+}
+
 #define TEST3_ARRAY_SIZE 100000
+#define TEST4_ARRAY_SIZE 100000
+#define TEST5_ARRAY_SIZE 10000
+#define TEST5_CLUSTER_SIZE 500
 
 int main(int argc, const char **argv){
     int32_t test1[]         = {1, 18, 3, 7, 9, 6, 106, 2, 75, 10, 5, -1};
     int32_t test1Expected[] = {-1, 1, 2, 3, 5, 6, 7, 9, 10, 18, 75, 106};
     int32_t test2[]         = {4, 18764, -3245, 75321, 9784, 631, 106, 20, 35, 109, 575, 4, -118, 20789, 2, 18};
     int32_t test2Expected[] = {-3245, -118, 2, 4, 4, 18, 20, 35, 106, 109, 575, 631, 9784, 18764, 20789, 75321};
+    int32_t test12Expected[] = {-3245, -118, -1, 1, 2, 2, 3, 4, 4, 5, 6, 7, 9, 10, 18, 18, 20, 35, 75, 106, 106, 109, 575, 631, 9784, 18764, 20789, 75321};
     int32_t test3[TEST3_ARRAY_SIZE] = {};
     int32_t test3Expected[TEST3_ARRAY_SIZE] = {};
+    static int32_t test4[TEST4_ARRAY_SIZE] = {};
+    static int32_t test4Expected[TEST4_ARRAY_SIZE] = {};
+    static int32_t test5A[TEST5_ARRAY_SIZE] = {};
+    static int32_t test5B[TEST5_ARRAY_SIZE] = {};
+    static int32_t test5Expected[2*TEST5_ARRAY_SIZE] = {};
 
     runSortTest(0, ARRAY_SIZE(test1), integerListMergeSort, test1, test1Expected);
     runSortTest(1, ARRAY_SIZE(test1), naiveSort, test1, test1Expected);
@@ -159,8 +1412,200 @@ int main(int argc, const char **argv){
         test3[(TEST3_ARRAY_SIZE-1)-i] = i;
     }
 
+    //Fill array with pseudo random values containing duplicates, negatives and short runs.
+    srand(1);
+    for (int i=0; i<TEST4_ARRAY_SIZE; i++) {
+        test4[i] = (i % 7 == 0) ? test4[i > 0 ? i-1 : 0] + 1 : (rand() % 20000) - 10000;
+        test4Expected[i] = test4[i];
+    }
+    qsort(test4Expected, TEST4_ARRAY_SIZE, sizeof(int32_t), compareIntegers);
+
     runSortTest(4, ARRAY_SIZE(test3), integerListMergeSort, test3, test3Expected);
     runSortTest(5, ARRAY_SIZE(test3), naiveSort, test3, test3Expected);
 
+    runSortTest(6, ARRAY_SIZE(test1), integerListMergeSortInPlace, test1, test1Expected);
+    runSortTest(7, ARRAY_SIZE(test2), integerListMergeSortInPlace, test2, test2Expected);
+    runSortTest(8, ARRAY_SIZE(test3), integerListMergeSortInPlace, test3, test3Expected);
+
+    runSortTest(9, ARRAY_SIZE(test1), integerListNaturalMergeSort, test1, test1Expected);
+    runSortTest(10, ARRAY_SIZE(test2), integerListNaturalMergeSort, test2, test2Expected);
+    runSortTest(11, ARRAY_SIZE(test3), integerListNaturalMergeSort, test3, test3Expected);
+    runSortTest(12, ARRAY_SIZE(test3Expected), integerListNaturalMergeSort, test3Expected, test3Expected);
+
+    runSortTest(13, ARRAY_SIZE(test4), integerListMergeSort, test4, test4Expected);
+    runSortTest(14, ARRAY_SIZE(test4), integerListMergeSortInPlace, test4, test4Expected);
+    runSortTest(15, ARRAY_SIZE(test4), integerListNaturalMergeSort, test4, test4Expected);
+    runSortTest(16, ARRAY_SIZE(test1), parallelSortForTesting, test1, test1Expected);
+    runSortTest(17, ARRAY_SIZE(test2), parallelSortForTesting, test2, test2Expected);
+    runSortTest(18, ARRAY_SIZE(test3), parallelSortForTesting, test3, test3Expected);
+    runSortTest(19, ARRAY_SIZE(test4), parallelSortForTesting, test4, test4Expected);
+    runSortTest(20, ARRAY_SIZE(test4), integerListParallelSort, test4, test4Expected);
+
+    testListKind = TEST_LIST_POOLED;
+    runSortTest(21, ARRAY_SIZE(test2), naiveSort, test2, test2Expected);
+    runSortTest(22, ARRAY_SIZE(test4), integerListMergeSort, test4, test4Expected);
+    runSortTest(23, ARRAY_SIZE(test4), integerListMergeSortInPlace, test4, test4Expected);
+    runSortTest(24, ARRAY_SIZE(test4), integerListNaturalMergeSort, test4, test4Expected);
+    runSortTest(25, ARRAY_SIZE(test4), parallelSortForTesting, test4, test4Expected);
+    testListKind = TEST_LIST_INLINE;
+    runSortTest(26, ARRAY_SIZE(test2), naiveSort, test2, test2Expected);
+    runSortTest(27, ARRAY_SIZE(test4), integerListMergeSort, test4, test4Expected);
+    runSortTest(28, ARRAY_SIZE(test4), integerListMergeSortInPlace, test4, test4Expected);
+    runSortTest(29, ARRAY_SIZE(test4), integerListNaturalMergeSort, test4, test4Expected);
+    runSortTest(30, ARRAY_SIZE(test4), parallelSortForTesting, test4, test4Expected);
+    runSortTest(31, ARRAY_SIZE(test4), blockSortForTesting, test4, test4Expected);
+    testListKind = TEST_LIST_POOLED;
+    runSortTest(32, ARRAY_SIZE(test4), blockSortForTesting, test4, test4Expected);
+    testListKind = TEST_LIST_BOXED;
+    runSortTest(33, ARRAY_SIZE(test1), blockSortForTesting, test1, test1Expected);
+    runSortTest(34, ARRAY_SIZE(test3), blockSortForTesting, test3, test3Expected);
+    runBlockRelinkTest(ARRAY_SIZE(test4), test4);
+    runSortTest(35, ARRAY_SIZE(test1), gatherValuesSortForTesting, test1, test1Expected);
+    runSortTest(36, ARRAY_SIZE(test4), gatherValuesSortForTesting, test4, test4Expected);
+    runGatherScratchTest(ARRAY_SIZE(test4), test4, test4Expected);
+    runAscendingCompareTest(ARRAY_SIZE(test4), test4, test4Expected);
+    runSortTest(37, ARRAY_SIZE(test2), integerListGatherRelinkSort, test2, test2Expected);
+    runSortTest(38, ARRAY_SIZE(test4), integerListGatherRelinkSort, test4, test4Expected);
+    runSortTest(39, ARRAY_SIZE(test3), gatherRadixRelinkSortForTesting, test3, test3Expected);
+    runSortTest(40, ARRAY_SIZE(test4), gatherRadixRelinkSortForTesting, test4, test4Expected);
+    integerListGatherSetThreshold(ARRAY_SIZE(test3));
+    runSortTest(41, ARRAY_SIZE(test1), integerListHybridSort, test1, test1Expected);
+    runSortTest(42, ARRAY_SIZE(test3), integerListHybridSort, test3, test3Expected);
+    integerListGatherSetThreshold(GATHER_SORT_DEFAULT_THRESHOLD);
+    runSortTest(43, ARRAY_SIZE(test1), specializedSortForTesting, test1, test1Expected);
+    runSortTest(44, ARRAY_SIZE(test3), specializedSortForTesting, test3, test3Expected);
+    runSortTest(45, ARRAY_SIZE(test4), specializedSortForTesting, test4, test4Expected);
+    runSortTest(46, ARRAY_SIZE(test4), integerListSpecializedSort, test4, test4Expected);
+    runPoolReuseTest();
+    runBulkGrowthTest(ARRAY_SIZE(test4), test4);
+
+    runUnrolledSortTest(0, ARRAY_SIZE(test1), test1, test1Expected);
+    runUnrolledSortTest(1, ARRAY_SIZE(test2), test2, test2Expected);
+    runUnrolledSortTest(2, ARRAY_SIZE(test3), test3, test3Expected);
+    runUnrolledSortTest(3, ARRAY_SIZE(test3Expected), test3Expected, test3Expected);
+    runUnrolledSortTest(4, ARRAY_SIZE(test4), test4, test4Expected);
+    runUnrolledInsertTest();
+
+    runCompactSortTest(0, ARRAY_SIZE(test1), test1, test1Expected);
+    runCompactSortTest(1, ARRAY_SIZE(test2), test2, test2Expected);
+    runCompactSortTest(2, ARRAY_SIZE(test3), test3, test3Expected);
+    runCompactSortTest(3, ARRAY_SIZE(test3Expected), test3Expected, test3Expected);
+    runCompactSortTest(4, ARRAY_SIZE(test4), test4, test4Expected);
+    runCompactInsertTest();
+
+    runRecordSortTest(0, 0, test1);
+    runRecordSortTest(1, ARRAY_SIZE(test1), test1);
+    runRecordSortTest(2, ARRAY_SIZE(test2), test2);
+    runRecordSortTest(3, ARRAY_SIZE(test3), test3);
+    runRecordSortTest(4, ARRAY_SIZE(test4), test4);
+
+    //Fill 2 sorted arrays whose values alternate in clusters, both lists share the values at the cluster edges.
+    for (int i=0; i<TEST5_ARRAY_SIZE; i++) {
+        int cluster = i / TEST5_CLUSTER_SIZE;
+        test5A[i] = (2*cluster)*TEST5_CLUSTER_SIZE + (i % TEST5_CLUSTER_SIZE);
+        test5B[i] = (2*cluster+1)*TEST5_CLUSTER_SIZE + (i % TEST5_CLUSTER_SIZE) - 1;
+        test5Expected[i] = test5A[i];
+        test5Expected[TEST5_ARRAY_SIZE+i] = test5B[i];
+    }
+    qsort(test5Expected, 2*TEST5_ARRAY_SIZE, sizeof(int32_t), compareIntegers);
+
+    runMergeTest(0, 0, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B, test5Expected);
+    runMergeTest(1, MERGE_SORT_DEFAULT_MIN_GALLOP, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B, test5Expected);
+    runMergeTest(2, 1, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B, test5Expected);
+    runMergeTest(3, 1, ARRAY_SIZE(test1Expected), test1Expected, ARRAY_SIZE(test2Expected), test2Expected, test12Expected);
+    testListKind = TEST_LIST_INLINE;
+    runMergeTest(4, MERGE_SORT_DEFAULT_MIN_GALLOP, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B, test5Expected);
+    testListKind = TEST_LIST_POOLED;
+    runMergeTest(5, MERGE_SORT_DEFAULT_MIN_GALLOP, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B, test5Expected);
+    testListKind = TEST_LIST_BOXED;
+
+    runSortedSetTest(0, 0, test1, ARRAY_SIZE(test2), test2);
+    runSortedSetTest(1, ARRAY_SIZE(test1), test1, ARRAY_SIZE(test2), test2);
+    runSortedSetTest(2, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B);
+    runSortedSetTest(3, ARRAY_SIZE(test4) / 2, test4, ARRAY_SIZE(test4) / 2, test4 + ARRAY_SIZE(test4) / 2);
+    runSortedSetTest(4, ARRAY_SIZE(test3Expected), test3Expected, ARRAY_SIZE(test4), test4);
+    testListKind = TEST_LIST_POOLED;
+    runSortedSetTest(5, ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B);
+    testListKind = TEST_LIST_BULK;
+    runSortedSetTest(6, ARRAY_SIZE(test4) / 2, test4, ARRAY_SIZE(test4) / 2, test4 + ARRAY_SIZE(test4) / 2);
+    testListKind = TEST_LIST_BOXED;
+    runSortedSetViewTest(ARRAY_SIZE(test5A), test5A, ARRAY_SIZE(test5B), test5B);
+
+    runMergeManyTest(0, 1, ARRAY_SIZE(test1), test1, test1Expected);
+    runMergeManyTest(1, 5, ARRAY_SIZE(test2), test2, test2Expected);
+    runMergeManyTest(2, 20, ARRAY_SIZE(test1), test1, test1Expected);
+    runMergeManyTest(3, 37, ARRAY_SIZE(test4), test4, test4Expected);
+    runMergeManyTest(4, 256, ARRAY_SIZE(test3), test3, test3Expected);
+
+    runPartialSortTest(0, 0, ARRAY_SIZE(test1), test1, test1Expected);
+    runPartialSortTest(1, 5, ARRAY_SIZE(test1), test1, test1Expected);
+    runPartialSortTest(2, 3, ARRAY_SIZE(test2), test2, test2Expected);
+    runPartialSortTest(3, 40, ARRAY_SIZE(test2), test2, test2Expected);
+    runPartialSortTest(4, 100, ARRAY_SIZE(test3), test3, test3Expected);
+    runPartialSortTest(5, 500, ARRAY_SIZE(test4), test4, test4Expected);
+    runPartialSortTest(6, 1, ARRAY_SIZE(test4), test4, test4Expected);
+
+    runSelectTest(0, 0, ARRAY_SIZE(test1), test1, test1Expected);
+    runSelectTest(1, ARRAY_SIZE(test1) - 1, ARRAY_SIZE(test1), test1, test1Expected);
+    runSelectTest(2, ARRAY_SIZE(test2) / 2, ARRAY_SIZE(test2), test2, test2Expected);
+    runSelectTest(3, ARRAY_SIZE(test3) / 2, ARRAY_SIZE(test3), test3, test3Expected);
+    runSelectTest(4, ARRAY_SIZE(test4) * 99 / 100, ARRAY_SIZE(test4), test4, test4Expected);
+    runSelectTest(5, 7, ARRAY_SIZE(test4), test4, test4Expected);
+
+    runIncrementalSortTest(0, 0, ARRAY_SIZE(test1), test1, test1Expected);
+    runIncrementalSortTest(1, 8, ARRAY_SIZE(test1), test1, test1Expected);
+    runIncrementalSortTest(2, ARRAY_SIZE(test2), ARRAY_SIZE(test2), test2, test2Expected);
+    runIncrementalSortTest(3, ARRAY_SIZE(test4) - 3000, ARRAY_SIZE(test4), test4, test4Expected);
+    testListKind = TEST_LIST_POOLED;
+    runIncrementalSortTest(4, ARRAY_SIZE(test3) - 1, ARRAY_SIZE(test3), test3, test3Expected);
+    testListKind = TEST_LIST_BOXED;
+
+    runSkipListTest(0, 0, test1);
+    runSkipListTest(1, ARRAY_SIZE(test1), test1);
+    runSkipListTest(2, ARRAY_SIZE(test2), test2);
+    runSkipListTest(3, ARRAY_SIZE(test4), test4);
+    testListKind = TEST_LIST_INLINE;
+    runSkipListTest(4, ARRAY_SIZE(test3), test3);
+    testListKind = TEST_LIST_POOLED;
+    runSkipListTest(5, ARRAY_SIZE(test4), test4);
+    testListKind = TEST_LIST_BOXED;
+
+    runSortTest(47, ARRAY_SIZE(test1), integerListInsertionSort, test1, test1Expected);
+    runSortTest(48, ARRAY_SIZE(test2), integerListInsertionSort, test2, test2Expected);
+    runSortTest(49, ARRAY_SIZE(test3Expected), integerListInsertionSort, test3Expected, test3Expected);
+    runSortTest(50, ARRAY_SIZE(test2), integerListAdaptiveSort, test2, test2Expected);
+    runSortTest(51, ARRAY_SIZE(test4), integerListAdaptiveSort, test4, test4Expected);
+
+    runAdaptiveSortTest(0, lessThanForTesting, ARRAY_SIZE(test1), test1, test1Expected, ADAPTIVE_SORT_INSERTION);
+    runAdaptiveSortTest(1, lessThanForTesting, ARRAY_SIZE(test3), test3, test3Expected, ADAPTIVE_SORT_NATURAL_MERGE);
+    runAdaptiveSortTest(2, lessThanForTesting, ARRAY_SIZE(test3Expected), test3Expected, test3Expected,
+                        ADAPTIVE_SORT_NATURAL_MERGE);
+    runAdaptiveSortTest(3, lessThanForTesting, ARRAY_SIZE(test4), test4, test4Expected, ADAPTIVE_SORT_MERGE);
+    runAdaptiveSortTest(4, lessThan, ARRAY_SIZE(test4), test4, test4Expected, ADAPTIVE_SORT_RADIX);
+    runAdaptiveSortTest(5, lessThan, ARRAY_SIZE(test2), test2, test2Expected, ADAPTIVE_SORT_INSERTION);
+    struct AdaptiveSortThresholds thresholds;
+    adaptiveSortGetThresholds(&thresholds);
+    struct AdaptiveSortThresholds tuned = thresholds;
+    tuned.parallelMinSize = ARRAY_SIZE(test4);
+    tuned.insertionMaxSize = 0;
+    adaptiveSortSetThresholds(&tuned);
+    runAdaptiveSortTest(6, lessThanForTesting, ARRAY_SIZE(test4), test4, test4Expected,
+                        (parallelSortDefaultThreads() > 1) ? ADAPTIVE_SORT_PARALLEL : ADAPTIVE_SORT_MERGE);
+    runAdaptiveSortTest(7, lessThanForTesting, ARRAY_SIZE(test1), test1, test1Expected, ADAPTIVE_SORT_MERGE);
+    adaptiveSortSetThresholds(&thresholds);
+
+    testListKind = TEST_LIST_BULK;
+    runSortTest(52, ARRAY_SIZE(test1), integerListMergeSortInPlace, test1, test1Expected);
+    runSortTest(53, ARRAY_SIZE(test4), integerListNaturalMergeSort, test4, test4Expected);
+    runIncrementalSortTest(5, ARRAY_SIZE(test4) / 2, ARRAY_SIZE(test4), test4, test4Expected);
+    testListKind = TEST_LIST_BOXED;
+    runSortTest(54, ARRAY_SIZE(test2), parallelRadixSortForTesting, test2, test2Expected);
+    runSortTest(55, ARRAY_SIZE(test4), parallelRadixSortForTesting, test4, test4Expected);
+
+    runViewTest(0, 0, test1, test1Expected);
+    runViewTest(1, ARRAY_SIZE(test1), test1, test1Expected);
+    runViewTest(2, ARRAY_SIZE(test2), test2, test2Expected);
+    runViewTest(3, ARRAY_SIZE(test4), test4, test4Expected);
+
     return 0;
 }
@@ -0,0 +1,125 @@
+/*
+ * Command line tool to sort binary files of int32_t values larger than the memory.
+ *
+ *  Usage: extsort [-m MEMORY_MB] [-t TEMP_DIR] [-f FAN_IN] INPUT OUTPUT
+ *         extsort --generate COUNT OUTPUT [SEED]
+ *         extsort --check INPUT
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "external_sort.h"
+#include "utils.h"
+
+/* Values written or checked at once */
+#define EXTSORT_BLOCK_SIZE (1024 * 1024)
+
+static void usage(const char *program){
+    fprintf(stderr, "Usage: %s [-m MEMORY_MB] [-t TEMP_DIR] [-f FAN_IN] INPUT OUTPUT\n", program);
+    fprintf(stderr, "       %s --generate COUNT OUTPUT [SEED]\n", program);
+    fprintf(stderr, "       %s --check INPUT\n", program);
+}
+
+/**
+ * \brief Write a file of count pseudo random int32_t values
+ */
+static int generate(size_t count, const char *path, uint64_t seed){
+    FILE *file = fopen(path, "wb");
+    if(file == NULL){
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    int32_t *block = (int32_t *) xzalloc(EXTSORT_BLOCK_SIZE, sizeof(int32_t));
+    uint64_t state = seed ? seed : 1;
+    bool ok = true;
+    while(ok && (count > 0)){
+        size_t n = (count < EXTSORT_BLOCK_SIZE) ? count : EXTSORT_BLOCK_SIZE;
+        for(size_t i = 0; i < n; i++){
+            /* xorshift64 */
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            block[i] = (int32_t) (uint32_t) state;
+        }
+        ok = (fwrite(block, sizeof(int32_t), n, file) == n);
+        count -= n;
+    }
+    free(block);
+    ok = (fclose(file) == 0) && ok;
+    if(!ok) perror(path);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * \brief Check that a file of int32_t values is sorted in ascending order
+ */
+static int check(const char *path){
+    FILE *file = fopen(path, "rb");
+    if(file == NULL){
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    int32_t *block = (int32_t *) xzalloc(EXTSORT_BLOCK_SIZE, sizeof(int32_t));
+    int64_t previous = INT64_MIN;
+    size_t total = 0;
+    bool sorted = true;
+    size_t n;
+    while(sorted && ((n = fread(block, sizeof(int32_t), EXTSORT_BLOCK_SIZE, file)) > 0)){
+        for(size_t i = 0; i < n; i++){
+            if(block[i] < previous){
+                fprintf(stderr, "%s is not sorted at position %lu\n", path, (unsigned long) (total + i));
+                sorted = false;
+                break;
+            }
+            previous = block[i];
+        }
+        total += n;
+    }
+    free(block);
+    fclose(file);
+    if(sorted) printf("%s is sorted, %lu values\n", path, (unsigned long) total);
+    return sorted ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, const char **argv){
+    if((argc >= 4) && (strcmp(argv[1], "--generate") == 0)){
+        uint64_t seed = (argc >= 5) ? strtoull(argv[4], NULL, 10) : 1;
+        return generate(strtoull(argv[2], NULL, 10), argv[3], seed);
+    }
+    if((argc == 3) && (strcmp(argv[1], "--check") == 0)){
+        return check(argv[2]);
+    }
+
+    struct ExternalSortOptions options;
+    externalSortDefaultOptions(&options);
+    int i = 1;
+    for(; (i + 1 < argc) && (argv[i][0] == '-'); i += 2){
+        if(strcmp(argv[i], "-m") == 0){
+            options.memoryBudget = strtoull(argv[i + 1], NULL, 10) * 1024 * 1024;
+        } else if(strcmp(argv[i], "-t") == 0){
+            options.tempDir = argv[i + 1];
+        } else if(strcmp(argv[i], "-f") == 0){
+            options.maxFanIn = strtoull(argv[i + 1], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(i + 2 != argc){
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    enum ListReturnType result = externalSortFile(argv[i], argv[i + 1], &options);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if(result != RET_OK) return EXIT_FAILURE;
+    printf("Sorted %s into %s in %.3f seconds\n", argv[i], argv[i + 1],
+           (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9);
+    return EXIT_SUCCESS;
+}